@@ -1,22 +1,116 @@
 #include "SoundManager.h"
+#include <QUrl>
 
 SoundManager* SoundManager::instance() {
     static SoundManager mgr;
     return &mgr;
 }
 
-SoundManager::SoundManager(QObject* parent) : QObject(parent) {}
+SoundManager::SoundManager(QObject* parent)
+    : QObject(parent)
+    , m_volume(1.0)
+    , m_maxVoices(MAX_VOICES)
+    , m_serial(0)
+    , m_stolenCount(0)
+{
+}
+
+void SoundManager::preload(const QString& resourcePath, int voices) {
+    QVector<Voice>& pool = m_voices[resourcePath];
+    while (pool.size() < qMax(1, voices)) {
+        Voice voice;
+        voice.effect = new QSoundEffect(this);
+        voice.effect->setSource(QUrl(resourcePath)); // 设置来源即开始加载解码
+        pool.append(voice);
+    }
+}
 
 void SoundManager::playEffect(const QString& resourcePath, qreal volume) {
-    if (!m_effects.contains(resourcePath)) {
-        QSoundEffect* effect = new QSoundEffect(this);
-        effect->setSource(QUrl(resourcePath));
-        effect->setVolume(volume);
-        m_effects[resourcePath] = effect;
-    }
-    auto effect = m_effects[resourcePath];
-    if (effect) {
-        effect->setVolume(volume);
-        effect->play();
+    if (!m_voices.contains(resourcePath)) {
+        preload(resourcePath); // 未预加载的音效首次播放时建立通道
+    }
+    Voice* voice = pickVoice(m_voices[resourcePath]);
+    enforcePolyphony(voice);
+    voice->startedAt = ++m_serial;
+    voice->effect->setVolume(qBound(0.0, volume * m_volume, 1.0));
+    voice->effect->play(); // 尚未加载完成时由QSoundEffect在加载后播放
+}
+
+void SoundManager::playSoundEffect(const QString& resourcePath) {
+    playEffect(resourcePath);
+}
+
+void SoundManager::stopAll() {
+    for (QVector<Voice>& pool : m_voices) {
+        for (Voice& voice : pool) {
+            voice.effect->stop();
+        }
+    }
+}
+
+void SoundManager::setVolume(qreal volume) {
+    m_volume = qBound(0.0, volume, 1.0);
+}
+
+void SoundManager::setMaxVoices(int voices) {
+    m_maxVoices = qMax(1, voices);
+    enforcePolyphony(nullptr);
+}
+
+int SoundManager::getVoiceCount() const {
+    int count = 0;
+    for (const QVector<Voice>& pool : m_voices) {
+        count += pool.size();
+    }
+    return count;
+}
+
+int SoundManager::getPlayingCount() const {
+    int count = 0;
+    for (const QVector<Voice>& pool : m_voices) {
+        for (const Voice& voice : pool) {
+            if (voice.effect->isPlaying()) ++count;
+        }
+    }
+    return count;
+}
+
+SoundManager::Voice* SoundManager::pickVoice(QVector<Voice>& voices) {
+    Voice* oldest = nullptr;
+    for (Voice& voice : voices) {
+        if (!voice.effect->isPlaying()) {
+            return &voice;
+        }
+        if (!oldest || voice.startedAt < oldest->startedAt) {
+            oldest = &voice;
+        }
+    }
+    oldest->effect->stop(); // 同一音效的通道全部在响，重新从头播放最早的一个
+    ++m_stolenCount;
+    return oldest;
+}
+
+void SoundManager::enforcePolyphony(const Voice* keep) {
+    // keep即将开始播放，要为它留出一个名额
+    const int limit = keep ? m_maxVoices - 1 : m_maxVoices;
+    int playing = 0;
+    for (const QVector<Voice>& pool : m_voices) {
+        for (const Voice& voice : pool) {
+            if (&voice != keep && voice.effect->isPlaying()) ++playing;
+        }
+    }
+    while (playing > limit) {
+        Voice* oldest = nullptr;
+        for (QVector<Voice>& pool : m_voices) {
+            for (Voice& voice : pool) {
+                if (&voice == keep || !voice.effect->isPlaying()) continue;
+                if (!oldest || voice.startedAt < oldest->startedAt) {
+                    oldest = &voice;
+                }
+            }
+        }
+        oldest->effect->stop();
+        ++m_stolenCount;
+        --playing;
     }
 }
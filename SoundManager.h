@@ -2,17 +2,51 @@
 #include <QObject>      // Qt对象基类
 #include <QSoundEffect> // Qt音效类
 #include <QMap>         // Qt字典
+#include <QVector>      // 发声通道列表
 #include <QString>      // Qt字符串
-#include <QPointer>     // Qt智能指针
 
-// 音效管理器单例类，负责全局音效播放
+// 音效管理器单例类，全局唯一的音效引擎
+//
+// 每个音效在启动时preload一次：创建固定数量的QSoundEffect发声通道（同一来源的解码数据由Qt共享），
+// 播放时只取一个空闲通道调用play，不再临时创建播放器或重新解码，点击到出声的延迟保持稳定。
+// 同时发声数不超过最大复音数；通道不够时抢占最早开始的一个（先在同一音效内找，再在全部通道中找），
+// 批量操作触发再多音效也只占用固定数量的通道。只在界面线程使用。
 class SoundManager : public QObject {
     Q_OBJECT
 public:
+    static const int VOICES_PER_EFFECT = 4; // 每个音效的默认通道数
+    static const int MAX_VOICES = 8;        // 默认最大复音数
+
     static SoundManager* instance(); // 获取单例实例
-    void playEffect(const QString& resourcePath, qreal volume = 1.0); // 播放音效，支持音量
+
+    void preload(const QString& resourcePath, int voices = VOICES_PER_EFFECT); // 预先解码音效并建立通道
+    void playEffect(const QString& resourcePath, qreal volume = 1.0); // 播放音效，音量再乘以全局音量
     void playSoundEffect(const QString& resourcePath); // 播放音效（默认音量）
+    void stopAll(); // 停止所有通道
+
+    void setVolume(qreal volume); // 全局音效音量（0.0~1.0）
+    qreal getVolume() const { return m_volume; }
+    void setMaxVoices(int voices); // 最大复音数（至少1）
+    int getMaxVoices() const { return m_maxVoices; }
+
+    int getVoiceCount() const;   // 已建立的通道数
+    int getPlayingCount() const; // 正在发声的通道数
+    int getStolenCount() const { return m_stolenCount; } // 累计被抢占的次数
+
 private:
+    // 一个发声通道：固定绑定一个音效来源
+    struct Voice {
+        QSoundEffect* effect = nullptr;
+        quint64 startedAt = 0; // 开始播放的序号，越小越早
+    };
+
     explicit SoundManager(QObject* parent = nullptr); // 构造函数（私有）
-    QMap<QString, QPointer<QSoundEffect>> m_effects; // 音效缓存字典
+    Voice* pickVoice(QVector<Voice>& voices); // 取空闲通道，没有则抢占同一音效中最早开始的
+    void enforcePolyphony(const Voice* keep); // 超出最大复音数时停掉最早开始的通道
+
+    QMap<QString, QVector<Voice>> m_voices; // 音效来源 -> 通道
+    qreal m_volume;
+    int m_maxVoices;
+    quint64 m_serial; // 播放序号
+    int m_stolenCount;
 };
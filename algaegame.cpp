@@ -1,42 +1,26 @@
 #include "algaegame.h"      // 游戏主逻辑头文件
-#include "mainwindow.h"     // 主窗口头文件
-#include <QDateTime>         // Qt时间类
+#include "replayrecorder.h" // 操作录制器
+#include <QSignalBlocker>    // 批量推进时屏蔽逐步的资源信号
 
 // AlgaeGame构造函数，初始化成员变量和游戏网格、资源
-AlgaeGame::AlgaeGame(QWidget* parent)
+AlgaeGame::AlgaeGame(QObject* parent)
     : QObject(parent)
-    , m_grid(new GameGrid(parent)) // 创建游戏网格
+    , m_grid(new GridModel()) // 创建网格模型
     , m_resources(new GameResources(this)) // 创建资源管理器
     , m_selectedAlgaeType(AlgaeType::NONE) // 初始无选中藻类
     , m_isGameRunning(false) // 游戏初始为暂停
     , m_updateTimer(new QTimer(this)) // 创建定时器
-    , m_lastUpdateTime(QDateTime::currentMSecsSinceEpoch()) // 记录当前时间
 {
-    // 初始化游戏网格，10行8列
-    m_grid->initialize(10, 8);  // 10行8列的网格
-    
-    // 连接网格信号到游戏槽函数
-    connect(m_grid, &GameGrid::gridChanged, this, &AlgaeGame::onGridChanged);
-    connect(m_grid, &GameGrid::resourcesChanged, this, &AlgaeGame::onResourcesChanged);
-    connect(m_grid, &GameGrid::cellClicked, this, [this](int row, int col) {
-        if (m_selectedAlgaeType != AlgaeType::NONE) {
-            plantAlgae(row, col); // 有选中藻类则种植
-        } else {
-            removeAlgae(row, col); // 否则移除
-        }
+    // 初始化游戏网格，默认10行8列，之后可用resizeGrid改变
+    m_grid->initialize(DEFAULT_ROWS, DEFAULT_COLS);
+
+    // 单元格变化只通知UI；生产速率在每次操作结束（onGridChanged）或下一步模拟时统一刷新，
+    // 批量变化（重置、应用布局）不会逐格重算
+    m_grid->setCellChangedCallback([this](int row, int col) {
+        emit cellChanged(row, col);
     });
-    
-    // 新增：监听所有AlgaeCell的cellChanged信号，自动刷新速率
-    for (int row = 0; row < m_grid->getRows(); ++row) {
-        for (int col = 0; col < m_grid->getCols(); ++col) {
-            AlgaeCell* cell = m_grid->getCell(row, col);
-            if (cell) {
-                connect(cell, &AlgaeCell::cellChanged, this, &AlgaeGame::onGridChanged);
-            }
-        }
-    }
-    
-    // 设置定时器，50ms刷新一次（提升流畅度）
+
+    // 设置定时器，50ms刷新一次（提升流畅度）；模拟本身按SIM_STEP固定步长推进
     m_updateTimer->setInterval(50);  // 50ms 刷新一次（20帧/秒）
     connect(m_updateTimer, &QTimer::timeout, this, &AlgaeGame::update);
 }
@@ -44,20 +28,34 @@ AlgaeGame::AlgaeGame(QWidget* parent)
 // 析构函数，停止定时器
 AlgaeGame::~AlgaeGame() {
     m_updateTimer->stop();
+    delete m_grid;
 }
 
 // 设置当前选中的藻类类型
 void AlgaeGame::setSelectedAlgaeType(AlgaeType::Type type) {
     if (m_selectedAlgaeType != type) {
         m_selectedAlgaeType = type;
+        if (m_recorder) {
+            m_recorder->recordInput(*this, ReplayLog::INPUT_SELECT, 0, 0, true, type);
+        }
         emit selectedAlgaeChanged(); // 通知UI
     }
 }
 
+// 挂上录制器并以当前状态开始录制
+void AlgaeGame::setRecorder(ReplayRecorder* recorder) {
+    m_recorder = recorder;
+    if (m_recorder) {
+        m_recorder->start(*this);
+    }
+}
+
 // 开始游戏，启动定时器
 void AlgaeGame::startGame() {
     if (!m_isGameRunning) {
         m_isGameRunning = true;
+        m_accumulator = 0.0;
+        m_frameClock.start(); // 暂停期间的时间不计入模拟
         m_updateTimer->start();
         emit gameStateChanged(); // 通知UI
     }
@@ -75,9 +73,24 @@ void AlgaeGame::pauseGame() {
 // 重置游戏，重置网格和资源，恢复初始状态
 void AlgaeGame::resetGame() {
     pauseGame();
+    if (m_recorder) {
+        m_recorder->sync(*this);
+    }
 
     // Reset grid and resources
     m_grid->reset();
+    resetState();
+    if (m_recorder) {
+        m_recorder->recordRestore(*this);
+    }
+}
+
+// 网格之外的游戏状态回到初始值（网格已重置或重建之后调用）
+void AlgaeGame::resetState() {
+    m_accumulator = 0.0;
+    m_simSteps = 0;
+    onGridChanged();
+    onResourcesChanged();
     m_resources->reset();
 
     // Reset selected algae type
@@ -87,36 +100,61 @@ void AlgaeGame::resetGame() {
     emit gameStateChanged();
 }
 
+// 按新尺寸重建网格并重置游戏
+bool AlgaeGame::resizeGrid(int rows, int cols) {
+    if (!GridModel::isValidSize(rows, cols)) {
+        return false;
+    }
+    pauseGame();
+    if (m_recorder) {
+        m_recorder->sync(*this);
+    }
+    m_grid->initialize(rows, cols); // 直接重建存储，不逐格移除，也不逐格通知
+    resetState();
+    if (m_recorder) {
+        m_recorder->recordRestore(*this);
+    }
+    emit gridResized();
+    return true;
+}
+
 // 在指定位置种植藻类
 bool AlgaeGame::plantAlgae(int row, int col) {
     if (!m_isGameRunning || m_selectedAlgaeType == AlgaeType::NONE) {
         return false;
     }
+    const bool planted = plantType(row, col, m_selectedAlgaeType);
+    onGridChanged();
+    if (m_recorder) {
+        m_recorder->recordInput(*this, ReplayLog::INPUT_PLANT, row, col, planted); // 失败时格子也可能已种下（光照略低）
+    }
+    return planted;
+}
+
+// 种植指定藻类：资源足够且光照允许时种下并扣除消耗
+bool AlgaeGame::plantType(int row, int col, AlgaeType::Type type) {
     double carb = m_resources->getCarbohydrates();
     double lipid = m_resources->getLipids();
     double pro = m_resources->getProteins();
     double vit = m_resources->getVitamins();
     double light = m_grid->getLightAt(row, col);
-    bool canAfford = AlgaeType::canAfford(m_selectedAlgaeType, carb, lipid, pro, vit);
+    bool canAfford = AlgaeType::canAfford(type, carb, lipid, pro, vit);
     if (!canAfford) {
         // 资源不足，不能种植
         return false;
     }
     bool canReserve = true;
-    AlgaeCell* cell = m_grid->getCell(row, col);
-    if (cell) {
-        AlgaeCell::PlantResult result = cell->plant(m_selectedAlgaeType, light, canAfford, canReserve);
+    if (m_grid->contains(row, col)) {
+        CellState::PlantResult result = m_grid->plant(row, col, type, light, canAfford, canReserve);
         m_lastPlantResult = result;
-        if (result == AlgaeCell::PLANT_SUCCESS) {
-            AlgaeType::Properties props = AlgaeType::getProperties(m_selectedAlgaeType);
+        if (result == CellState::PLANT_SUCCESS) {
+            const AlgaeType::Properties& props = AlgaeType::getProperties(type);
             m_resources->subtractCarbohydrates(props.plantCostCarb);
             m_resources->subtractLipids(props.plantCostLipid);
             m_resources->subtractProteins(props.plantCostPro);
             m_resources->subtractVitamins(props.plantCostVit);
-            updateProductionRates();
             return true;
         }
-        updateProductionRates();
         return false;
     }
     return false;
@@ -128,14 +166,85 @@ bool AlgaeGame::removeAlgae(int row, int col) {
         return false;
     }
 
-    AlgaeCell* cell = m_grid->getCell(row, col);
-    if (cell && cell->isOccupied()) {
-        cell->remove();
-        updateProductionRates();
-        return true;
+    const bool removed = m_grid->remove(row, col);
+    if (removed) {
+        onResourcesChanged(); // 移除奖励改变了局部资源
+        onGridChanged();
     }
+    if (m_recorder) {
+        m_recorder->recordInput(*this, ReplayLog::INPUT_REMOVE, row, col, removed);
+    }
+    return removed;
+}
 
-    return false;
+// 把网格改成指定布局
+int AlgaeGame::applyLayout(const GridLayout& layout) {
+    if (layout.rows != m_grid->getRows() || layout.cols != m_grid->getCols()) {
+        return 0;
+    }
+    QSignalBlocker blocker(m_resources); // 逐格的资源信号在最后统一发出
+    // 先移除与布局不同的格子（移除奖励照常发放）
+    for (int row = 0; row < layout.rows; ++row) {
+        for (int col = 0; col < layout.cols; ++col) {
+            const AlgaeType::Type current = m_grid->getTypeAt(row, col);
+            if (current != AlgaeType::NONE && current != layout.at(row, col)) {
+                m_grid->remove(row, col);
+            }
+        }
+    }
+    // 按布局的种植顺序种：蓝藻先种，其余自下而上，下方格子种植时还没有新种的上方遮光
+    int planted = 0;
+    for (int k : layout.plantingOrder()) {
+        const int row = k / layout.cols;
+        const int col = k % layout.cols;
+        const AlgaeType::Type type = layout.cells[k];
+        if (m_grid->getTypeAt(row, col) != type && plantType(row, col, type)) {
+            ++planted;
+        }
+    }
+    onResourcesChanged();
+    onGridChanged();
+    if (m_recorder) {
+        m_recorder->recordRestore(*this); // 按布局种植不经过plantAlgae，回放时直接恢复结果
+    }
+    blocker.unblock();
+    emit m_resources->resourcesChanged();
+    emit m_resources->productionRatesChanged();
+    return planted;
+}
+
+// 恢复存档
+bool AlgaeGame::loadSave(const SaveGame& save) {
+    // 先校验再动任何状态：无效的存档不影响游戏，也不让录制器提前同步
+    if (save.selectedType < AlgaeType::NONE || save.selectedType >= AlgaeType::TYPE_COUNT ||
+        !GridModel::isValidState(save.grid)) {
+        return false;
+    }
+    const bool resized = save.grid.rows != m_grid->getRows() || save.grid.cols != m_grid->getCols();
+    if (m_recorder) {
+        m_recorder->sync(*this); // 步号在状态被替换之前同步
+    }
+    m_grid->restoreState(save.grid); // 已校验过，不会失败
+    pauseGame();
+    m_accumulator = 0.0;
+    m_simSteps = save.simSteps;
+    m_resources->setAmounts(save.resources[0], save.resources[1], save.resources[2], save.resources[3]);
+    onGridChanged(); // 生产速率按恢复后的产量合计刷新
+    onResourcesChanged();
+    const bool selectionChanged = m_selectedAlgaeType != save.selectedType;
+    m_selectedAlgaeType = save.selectedType; // 不作为玩家操作录制，存档关键帧里已有
+    if (m_recorder) {
+        m_recorder->recordRestore(*this);
+    }
+    if (selectionChanged) {
+        emit selectedAlgaeChanged();
+    }
+    if (resized) {
+        emit gridResized();
+    }
+    emit gridUpdated();
+    emit gameStateChanged();
+    return true;
 }
 
 // 删除音量设置函数
@@ -147,58 +256,98 @@ bool AlgaeGame::removeAlgae(int row, int col) {
 //     m_soundEffectsVolume = qBound(0, volume, 100);
 // }
 
-// 游戏主循环，每帧调用
+void AlgaeGame::setSimSpeed(SimSpeed speed) {
+    if (m_simSpeed != speed) {
+        m_simSpeed = speed;
+        m_accumulator = 0.0; // 切换速度时丢弃未消化的时间，避免一帧内突然追赶
+        emit simSpeedChanged();
+    }
+}
+
+// 游戏主循环，每帧调用：按真实时间累积，再以固定步长推进模拟
+// 同样的操作序列在任何帧率下都得到相同的结果
 void AlgaeGame::update() {
     if (!m_isGameRunning) {
         return;
     }
-    // 计算时间增量
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-    double deltaTime = (currentTime - m_lastUpdateTime) / 1000.0; // 转换为秒
-    m_lastUpdateTime = currentTime;
-    // 更新网格（更新所有单元格）
-    m_grid->update(deltaTime);
-    // 根据生产速率更新资源
-    m_resources->update(deltaTime);
-    // 检查胜利条件
-    if (m_resources->checkWinCondition()) {
+    // 计算真实帧间隔（单调时钟），卡顿时最多追赶MAX_FRAME_TIME
+    const double frameTime = qMin(m_frameClock.restart() / 1000.0, MAX_FRAME_TIME);
+
+    bool won = false;
+    int steps = 0;
+    {
+        QSignalBlocker blocker(m_resources); // 逐步的资源信号在帧末统一发出
+        if (m_simSpeed == SPEED_MAX) {
+            // 最快速度：在时间预算内尽量多跑
+            QElapsedTimer budget;
+            budget.start();
+            do {
+                won = stepSimulation() || won;
+                ++steps;
+            } while (budget.nsecsElapsed() < MAX_SPEED_BUDGET_NS);
+        } else {
+            m_accumulator += frameTime * m_simSpeed;
+            while (m_accumulator >= SIM_STEP) {
+                won = stepSimulation() || won;
+                m_accumulator -= SIM_STEP;
+                ++steps;
+            }
+        }
+    }
+    if (steps > 0) {
+        finishFrame(won);
+    }
+}
+
+// 不看真实时间，直接推进若干固定步
+int AlgaeGame::advance(int steps) {
+    bool won = false;
+    {
+        QSignalBlocker blocker(m_resources);
+        for (int i = 0; i < steps; ++i) {
+            won = stepSimulation() || won;
+        }
+    }
+    if (steps > 0) {
+        finishFrame(won);
+    }
+    return qMax(0, steps);
+}
+
+// 推进一个固定步：网格 → 生产速率 → 资源累积
+bool AlgaeGame::stepSimulation() {
+    m_grid->update(SIM_STEP);
+    updateProductionRates();
+    m_resources->update(SIM_STEP);
+    ++m_simSteps;
+    return m_resources->checkWinCondition();
+}
+
+// 一帧的模拟结束后统一通知界面
+void AlgaeGame::finishFrame(bool won) {
+    if (m_recorder) {
+        m_recorder->recordFrame(*this);
+    }
+    onResourcesChanged();
+    if (won) {
         emit gameWon();
     }
     // 新增：每帧刷新UI网格和胜利条件栏
-    emit m_grid->gridUpdated();
+    emit gridUpdated();
+    emit m_resources->productionRatesChanged();
     emit m_resources->resourcesChanged();
 }
 
-// 计算所有单元格的生产速率总和，并更新资源
+// 把网格的产量合计设为生产速率：合计由GridModel随单格产量变化增量维护，O(1)
 void AlgaeGame::updateProductionRates() {
-    // Calculate total production rates from all cells
-    double totalCarb = 0.0;
-    double totalLipid = 0.0;
-    double totalPro = 0.0;
-    double totalVit = 0.0;
-
-    for (int row = 0; row < m_grid->getRows(); ++row) {
-        for (int col = 0; col < m_grid->getCols(); ++col) {
-            AlgaeCell* cell = m_grid->getCell(row, col);
-            if (cell && cell->isOccupied()) {
-                totalCarb += cell->getCarbProduction();
-                totalLipid += cell->getLipidProduction();
-                totalPro += cell->getProProduction();
-                totalVit += cell->getVitProduction();
-            }
-        }
-    }
-
-    // Update resources with new rates
-    m_resources->setCarbRate(totalCarb);
-    m_resources->setLipidRate(totalLipid);
-    m_resources->setProRate(totalPro);
-    m_resources->setVitRate(totalVit);
+    const GridModel::ProduceSums totals = m_grid->getProductionTotals();
+    m_resources->setRates(totals.carb, totals.lipid, totals.pro, totals.vit);
 }
 
 // 网格变化时自动刷新生产速率和胜利判定
 void AlgaeGame::onGridChanged() {
-    // 更新资源生产速率
+    // 只重算这次操作影响到的格子，再更新资源生产速率
+    m_grid->recomputeDirtyProduction();
     updateProductionRates();
     
     // 检查游戏状态
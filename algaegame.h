@@ -3,11 +3,16 @@
 
 #include <QObject>      // Qt对象基类
 #include <QTimer>       // Qt定时器
-#include "gamegrid.h" // 游戏网格类
+#include <QElapsedTimer> // 单调时钟，测量真实帧间隔
+#include "gridmodel.h" // 网格模型（无界面）
 #include "gameresources.h" // 资源管理类
 #include "algaetype.h"     // 藻类类型定义
+#include "gridlayout.h"    // 网格布局
+#include "savegame.h"      // 游戏存档
 
-// 游戏主逻辑类，负责管理网格、资源、状态、信号等
+class ReplayRecorder;
+
+// 游戏主逻辑类，负责管理网格、资源、状态、信号等（只依赖QtCore，可无界面运行）
 class AlgaeGame : public QObject {
     Q_OBJECT
 
@@ -16,18 +21,33 @@ class AlgaeGame : public QObject {
     Q_PROPERTY(AlgaeType::Type selectedAlgaeType READ getSelectedAlgaeType WRITE setSelectedAlgaeType NOTIFY selectedAlgaeChanged)
 
 public:
-    explicit AlgaeGame(QWidget* parent = nullptr); // 构造函数
+    // 模拟速度（每帧按真实时间×倍率推进固定步长；MAX为每帧在时间预算内尽量多跑）
+    enum SimSpeed { SPEED_1X = 1, SPEED_4X = 4, SPEED_16X = 16, SPEED_MAX = 0 };
+
+    static constexpr double SIM_STEP = 0.05;        // 固定模拟步长（秒），与原50ms帧一致
+    static constexpr double MAX_FRAME_TIME = 0.25;  // 单帧最多追赶的真实时间（秒），防止卡顿后雪崩
+    static constexpr qint64 MAX_SPEED_BUDGET_NS = 12000000; // MAX速度下每帧的模拟时间预算（12ms，50ms帧里给界面留出绘制与输入的时间）
+    static const int DEFAULT_ROWS = 10; // 默认网格行数
+    static const int DEFAULT_COLS = 8;  // 默认网格列数
+
+    explicit AlgaeGame(QObject* parent = nullptr); // 构造函数
     ~AlgaeGame(); // 析构函数
 
     // 游戏状态
     bool isGameRunning() const { return m_isGameRunning; } // 是否正在运行
+    SimSpeed getSimSpeed() const { return m_simSpeed; }     // 获取模拟速度
+    void setSimSpeed(SimSpeed speed);                      // 设置模拟速度
+    qint64 getSimStepCount() const { return m_simSteps; }  // 已模拟的固定步数
+    double getSimTime() const { return m_simSteps * SIM_STEP; } // 已模拟的时间（秒）
 
     // 藻类选择
     AlgaeType::Type getSelectedAlgaeType() const { return m_selectedAlgaeType; } // 获取当前选中藻类
     void setSelectedAlgaeType(AlgaeType::Type type); // 设置选中藻类
 
     // 网格访问
-    GameGrid* getGrid() const { return m_grid; } // 获取网格指针
+    GridModel* getGrid() const { return m_grid; } // 获取网格模型指针
+    // 按新尺寸重建网格并重置游戏（基础光照按当前光照曲线生成），尺寸无效时返回false
+    bool resizeGrid(int rows, int cols);
 
     // 资源访问
     GameResources* getResources() const { return m_resources; } // 获取资源指针
@@ -36,16 +56,26 @@ public:
     void startGame();  // 开始游戏
     void pauseGame();  // 暂停游戏
     void resetGame();  // 重置游戏
+    int advance(int steps); // 不看真实时间，直接推进若干固定步（无界面批量运行用），返回实际步数
 
     // 单元格交互
     bool plantAlgae(int row, int col);   // 种植藻类
     bool removeAlgae(int row, int col);  // 移除藻类
+    // 把网格改成指定布局（尺寸需一致）：先移除不同的格子，再按游戏规则种植并扣除消耗，
+    // 蓝藻先种、其余自下而上种，尽量不被新种的遮光挡住；不要求游戏处于运行状态，返回新种成功的格子数
+    int applyLayout(const GridLayout& layout);
+    // 恢复存档（SaveGame::fromGame取得的状态）：游戏暂停，网格尺寸不同时重建，存档无效时返回false且不做修改
+    bool loadSave(const SaveGame& save);
 
     // 设置（已注释掉音量相关）
     void setMusicVolume(int volume);         // 设置音乐音量（已废弃）
     void setSoundEffectsVolume(int volume);  // 设置音效音量（已废弃）
 
-    AlgaeCell::PlantResult getLastPlantResult() const { return m_lastPlantResult; } // 获取上次种植结果
+    CellState::PlantResult getLastPlantResult() const { return m_lastPlantResult; } // 获取上次种植结果
+
+    // 操作录像：挂上录制器时以当前状态开始录制（录制器不归游戏所有），传nullptr停止录制
+    void setRecorder(ReplayRecorder* recorder);
+    ReplayRecorder* getRecorder() const { return m_recorder; }
 
 public slots:
     void update();           // 游戏主循环
@@ -57,24 +87,36 @@ signals:
     void selectedAlgaeChanged();  // 选中藻类变化信号
     void gameWon();               // 游戏胜利信号
     void resourcesUpdated();      // 资源刷新信号
+    void gridUpdated();           // 网格每帧刷新信号
+    void cellChanged(int row, int col); // 单元格变化信号
+    void simSpeedChanged();             // 模拟速度变化信号
+    void gridResized();                 // 网格尺寸变化信号（视图需重建）
 
 private:
     bool m_isGameRunning;           // 游戏是否运行中
     AlgaeType::Type m_selectedAlgaeType; // 当前选中藻类
 
-    QTimer* m_updateTimer;          // 游戏主循环定时器
-    qint64 m_lastUpdateTime;        // 上次更新时间戳
+    QTimer* m_updateTimer;          // 游戏主循环定时器（只负责驱动帧，模拟按固定步长推进）
+    QElapsedTimer m_frameClock;     // 帧间隔计时
+    double m_accumulator = 0.0;     // 尚未模拟的时间（秒）
+    SimSpeed m_simSpeed = SPEED_1X; // 当前模拟速度
+    qint64 m_simSteps = 0;          // 已模拟的固定步数
 
-    GameGrid* m_grid;               // 游戏网格指针
+    GridModel* m_grid;              // 游戏网格模型
     GameResources* m_resources;     // 资源管理指针
 
-    AlgaeCell::PlantResult m_lastPlantResult = AlgaeCell::PLANT_SUCCESS; // 上次种植结果
+    CellState::PlantResult m_lastPlantResult = CellState::PLANT_SUCCESS; // 上次种植结果
+    ReplayRecorder* m_recorder = nullptr; // 操作录制器（为空时不录制）
 
     // 删除音乐相关成员
     // int m_musicVolume;
     // int m_soundEffectsVolume;
 
     void updateProductionRates(); // 更新生产速率
+    void resetState();            // 网格之外的状态回到初始值
+    bool plantType(int row, int col, AlgaeType::Type type); // 种植指定藻类并扣除消耗（不检查运行状态）
+    bool stepSimulation();        // 推进一个固定步，返回是否达成胜利条件
+    void finishFrame(bool won);   // 一帧的模拟结束后统一通知界面
 };
 
 #endif // ALGAEGAME_H
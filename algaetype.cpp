@@ -1,165 +1,73 @@
 #include "algaetype.h" // 藻类类型定义头文件
-#include <QColor>        // Qt颜色类
+#include <QtGlobal>      // qMax
 
-// 获取指定类型的属性
-AlgaeType::Properties AlgaeType::getProperties(Type type) {
-    Properties props;
-    switch (type) {
-        case TYPE_A:
-            props.name = "螺旋藻 Spirulina";
-            props.lightRequiredPlant = 22;      // 种植所需光照
-            props.lightRequiredMaintain = 18;   // 维持所需光照
-            props.lightRequiredSurvive = 12;    // 存活所需光照
-            props.plantCostCarb = 20;           // 种植消耗糖类
-            props.plantCostLipid = 0;           // 种植消耗脂质
-            props.plantCostPro = 10;            // 种植消耗蛋白质
-            props.plantCostVit = 0;             // 种植消耗维生素
-            props.shadingDepth = 1;             // 遮光深度
-            props.shadingAmount = 8;            // 遮光强度
-            props.consumeRateN = 1;             // 每秒消耗氮
-            props.consumeRateC = 8;             // 每秒消耗碳
-            props.produceRateCarb = 5;          // 每秒产糖
-            props.produceRateLipid = 0;         // 每秒产脂质
-            props.produceRatePro = 2;           // 每秒产蛋白
-            props.produceRateVit = 0;           // 每秒产维生素
-            props.imagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_a.png"; // 图标
-            props.hoverImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_a.png";
-            props.selectedImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_a.png";
-            props.cursorImagePath = "";
-            props.shadingColor = QColor(0, 0, 0, 50); // 遮荫色
-            break;
+namespace {
 
-        case TYPE_B:
-            props.name = "小球藻 Chlorella";
-            props.lightRequiredPlant = 18;
-            props.lightRequiredMaintain = 14;
-            props.lightRequiredSurvive = 10;
-            props.plantCostCarb = 16;
-            props.plantCostLipid = 12;
-            props.plantCostPro = 0;
-            props.plantCostVit = 4;
-            props.shadingDepth = 2;
-            props.shadingAmount = 5;
-            props.consumeRateN = 2;
-            props.consumeRateC = 6;
-            props.produceRateCarb = 3;
-            props.produceRateLipid = 4;
-            props.produceRatePro = 0;
-            props.produceRateVit = 1;
-            props.imagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_b.png";
-            props.hoverImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_b.png";
-            props.selectedImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_b.png";
-            props.cursorImagePath = "";
-            props.shadingColor = QColor(0, 0, 0, 30);
-            break;
+// 数值属性表，按Type枚举顺序排列
+// 列顺序：种植/维持/存活光照，种植消耗（糖/脂/蛋白/维生素），遮光深度/强度，
+//         每秒消耗（氮/碳），每秒产出（糖/脂/蛋白/维生素）
+const AlgaeType::Properties kProperties[AlgaeType::TYPE_COUNT] = {
+    // NONE
+    {  0,  0,  0,   0,  0,  0,  0,   0, 0,   0.0,  0.0,   0.0, 0.0, 0.0, 0.0 },
+    // TYPE_A 螺旋藻
+    { 22, 18, 12,  20,  0, 10,  0,   1, 8,   1.0,  8.0,   5.0, 0.0, 2.0, 0.0 },
+    // TYPE_B 小球藻
+    { 18, 14, 10,  16, 12,  0,  4,   2, 5,   2.0,  6.0,   3.0, 4.0, 0.0, 1.0 },
+    // TYPE_C 小型硅藻：种植消耗与氮碳消耗提升，产量降低
+    { 12,  8,  6,  16,  0,  8, 24,   0, 0,   3.0, 18.0,   1.5, 0.0, 1.5, 2.5 },
+    // TYPE_D 裸藻
+    { 16, 12,  8,  12,  8,  6,  6,   1, 4,   1.5,  7.0,   2.5, 1.5, 1.5, 1.5 },
+    // TYPE_E 蓝藻
+    {  8,  4,  2,  10,  6,  4,  4,   0, 0,   1.0,  5.0,   2.0, 1.0, 1.0, 1.0 },
+};
 
-        case TYPE_C:
-            props.name = "小型硅藻 Cyclotella";
-            props.lightRequiredPlant = 12;
-            props.lightRequiredMaintain = 8;
-            props.lightRequiredSurvive = 6;
-            props.plantCostCarb = 16;      // 糖消耗提升
-            props.plantCostLipid = 0;
-            props.plantCostPro = 8;        // 蛋白消耗提升
-            props.plantCostVit = 24;       // 维生素消耗提升
-            props.shadingDepth = 0;
-            props.shadingAmount = 0;
-            props.consumeRateN = 3;        // 氮消耗提升
-            props.consumeRateC = 18;       // 碳消耗提升
-            props.produceRateCarb = 1.5;   // 糖产量降低
-            props.produceRateLipid = 0;
-            props.produceRatePro = 1.5;    // 蛋白产量降低
-            props.produceRateVit = 2.5;    // 维生素产量降低
-            props.imagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_c.png";
-            props.hoverImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_c.png";
-            props.selectedImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_c.png";
-            props.cursorImagePath = "";
-            props.shadingColor = QColor(0, 0, 0, 0);
-            break;
+// 类型越界时按NONE处理
+int tableIndex(AlgaeType::Type type) {
+    return (type >= AlgaeType::NONE && type < AlgaeType::TYPE_COUNT) ? type : AlgaeType::NONE;
+}
+
+} // namespace
 
-        case TYPE_D:
-            props.name = "裸藻 Euglena";
-            props.lightRequiredPlant = 16;
-            props.lightRequiredMaintain = 12;
-            props.lightRequiredSurvive = 8;
-            props.plantCostCarb = 12;
-            props.plantCostLipid = 8;
-            props.plantCostPro = 6;
-            props.plantCostVit = 6;
-            props.shadingDepth = 1;
-            props.shadingAmount = 4;
-            props.consumeRateN = 1.5;
-            props.consumeRateC = 7;
-            props.produceRateCarb = 2.5;
-            props.produceRateLipid = 1.5;
-            props.produceRatePro = 1.5;
-            props.produceRateVit = 1.5;
-            props.imagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_d.png";
-            props.hoverImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_d.png";
-            props.selectedImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_d.png";
-            props.cursorImagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_d.png";
-            props.shadingColor = QColor(0, 120, 255, 40);
-            break;
+// 获取指定类型的数值属性
+const AlgaeType::Properties& AlgaeType::getProperties(Type type) {
+    return kProperties[tableIndex(type)];
+}
 
-        case TYPE_E:
-            props.name = "蓝藻 Cyanobacteria";
-            props.lightRequiredPlant = 8;
-            props.lightRequiredMaintain = 4;
-            props.lightRequiredSurvive = 2;
-            props.plantCostCarb = 10;
-            props.plantCostLipid = 6;
-            props.plantCostPro = 4;
-            props.plantCostVit = 4;
-            props.shadingDepth = 0;
-            props.shadingAmount = 0;
-            props.consumeRateN = 1.0;
-            props.consumeRateC = 5.0;
-            props.produceRateCarb = 2.0;
-            props.produceRateLipid = 1.0;
-            props.produceRatePro = 1.0;
-            props.produceRateVit = 1.0;
-            props.imagePath = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_e.png";
-            props.hoverImagePath = props.imagePath;
-            props.selectedImagePath = props.imagePath;
-            props.cursorImagePath = props.imagePath;
-            props.shadingColor = QColor(255, 215, 0, 80);
-            break;
+// 所有类型中最大的遮光深度
+int AlgaeType::getMaxShadingDepth() {
+    static const int maxDepth = [] {
+        int depth = 0;
+        for (const Properties& props : kProperties) {
+            depth = qMax(depth, props.shadingDepth);
+        }
+        return depth;
+    }();
+    return maxDepth;
+}
 
-        default:
-            props.name = "";
-            props.lightRequiredPlant = 0;
-            props.lightRequiredMaintain = 0;
-            props.lightRequiredSurvive = 0;
-            props.plantCostCarb = 0;
-            props.plantCostLipid = 0;
-            props.plantCostPro = 0;
-            props.plantCostVit = 0;
-            props.shadingDepth = 0;
-            props.shadingAmount = 0;
-            props.consumeRateN = 0;
-            props.consumeRateC = 0;
-            props.produceRateCarb = 0;
-            props.produceRateLipid = 0;
-            props.produceRatePro = 0;
-            props.produceRateVit = 0;
-            props.imagePath = "";
-            props.hoverImagePath = "";
-            props.selectedImagePath = "";
-            props.cursorImagePath = "";
-            props.shadingColor = QColor(0, 0, 0, 0);
-            break;
-    }
-    return props;
+// 获取指定类型的界面信息（首次调用时构建）
+const AlgaeType::Info& AlgaeType::getInfo(Type type) {
+    static const QString kImageDir = ":/resources/st30f0n665joahrrvuj05fechvwkcv10/";
+    static const Info kInfo[TYPE_COUNT] = {
+        // 名称，图标，悬停图，选中图，鼠标指针图，遮荫色
+        { "", "", "", "", "", 0x00000000u },
+        { "螺旋藻 Spirulina", kImageDir + "type_a.png", kImageDir + "type_a.png", kImageDir + "type_a.png", "", 0x32000000u },
+        { "小球藻 Chlorella", kImageDir + "type_b.png", kImageDir + "type_b.png", kImageDir + "type_b.png", "", 0x1E000000u },
+        { "小型硅藻 Cyclotella", kImageDir + "type_c.png", kImageDir + "type_c.png", kImageDir + "type_c.png", "", 0x00000000u },
+        { "裸藻 Euglena", kImageDir + "type_d.png", kImageDir + "type_d.png", kImageDir + "type_d.png", kImageDir + "type_d.png", 0x280078FFu },
+        { "蓝藻 Cyanobacteria", kImageDir + "type_e.png", kImageDir + "type_e.png", kImageDir + "type_e.png", kImageDir + "type_e.png", 0x50FFD700u },
+    };
+    return kInfo[tableIndex(type)];
 }
 
 // 获取类型名称
 QString AlgaeType::getTypeName(Type type) {
-    return getProperties(type).name;
+    return getInfo(type).name;
 }
 
 // 判断资源是否足够种植
 bool AlgaeType::canAfford(Type type, double carb, double lipid, double pro, double vit) {
-    Properties props = getProperties(type);
+    const Properties& props = getProperties(type);
     return carb >= props.plantCostCarb &&
            lipid >= props.plantCostLipid &&
            pro >= props.plantCostPro &&
@@ -168,7 +76,7 @@ bool AlgaeType::canAfford(Type type, double carb, double lipid, double pro, doub
 
 // 扣除种植消耗
 void AlgaeType::deductPlantingCost(Type type, double& carb, double& lipid, double& pro, double& vit) {
-    Properties props = getProperties(type);
+    const Properties& props = getProperties(type);
     carb -= props.plantCostCarb;
     lipid -= props.plantCostLipid;
     pro -= props.plantCostPro;
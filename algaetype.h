@@ -3,17 +3,16 @@
 #define ALGAETYPE_H
 
 #include <QString> // Qt字符串类
-#include <QColor>  // Qt颜色类
 
 // 藻类类型及属性定义类
 class AlgaeType {
 public:
     // 藻类类型枚举
     enum Type { NONE, TYPE_A, TYPE_B, TYPE_C, TYPE_D, TYPE_E };
+    static const int TYPE_COUNT = TYPE_E + 1; // 类型总数（含NONE）
 
-    // 藻类属性结构体
+    // 藻类数值属性（模拟内循环使用，纯数据，按引用获取）
     struct Properties {
-        QString name;              // 名称
         int lightRequiredPlant;    // 种植所需光照
         int lightRequiredMaintain; // 维持所需光照
         int lightRequiredSurvive;  // 存活所需最低光照
@@ -29,15 +28,24 @@ public:
         double produceRateLipid;   // 每秒产脂质
         double produceRatePro;     // 每秒产蛋白
         double produceRateVit;     // 每秒产维生素
+    };
+
+    // 藻类界面信息（名称、图片、颜色，只在界面层使用）
+    struct Info {
+        QString name;              // 名称
         QString imagePath;         // 图标路径
         QString hoverImagePath;    // 鼠标悬停图片
         QString selectedImagePath; // 选中图片
         QString cursorImagePath;   // 鼠标指针图片
-        QColor shadingColor;       // 遮荫区颜色
+        quint32 shadingColor;      // 遮荫区颜色（0xAARRGGBB，用QColor::fromRgba转换）
     };
 
-    // 获取指定类型的属性
-    static Properties getProperties(Type type);
+    // 获取指定类型的数值属性（常量表，程序启动时构建）
+    static const Properties& getProperties(Type type);
+    // 所有类型中最大的遮光深度（遮荫影响范围的上限）
+    static int getMaxShadingDepth();
+    // 获取指定类型的界面信息
+    static const Info& getInfo(Type type);
     // 获取类型名称
     static QString getTypeName(Type type);
     // 判断资源是否足够种植
@@ -0,0 +1,111 @@
+#include "autosaver.h"    // 后台自动存档头文件
+#include <QElapsedTimer>  // 计时器
+
+AutoSaver::AutoSaver(const QString& path, QObject* parent)
+    : QObject(parent)
+    , m_path(path)
+    , m_busy(false)
+    , m_stop(false)
+    , m_savedCount(0)
+    , m_skippedCount(0)
+    , m_lastSaveNs(0)
+{
+    m_thread = std::thread(&AutoSaver::workerLoop, this);
+}
+
+AutoSaver::~AutoSaver()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+std::unique_ptr<SaveGame> AutoSaver::takeBuffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_spare) {
+            return std::move(m_spare);
+        }
+    }
+    return std::unique_ptr<SaveGame>(new SaveGame());
+}
+
+void AutoSaver::submit(std::unique_ptr<SaveGame> save)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending) {
+            ++m_skippedCount; // 还没开始写的旧存档直接被替换，留作缓冲
+            m_spare = std::move(m_pending);
+        }
+        m_pending = std::move(save);
+    }
+    m_wake.notify_one();
+}
+
+void AutoSaver::submit(SaveGame save)
+{
+    submit(std::unique_ptr<SaveGame>(new SaveGame(std::move(save))));
+}
+
+void AutoSaver::waitForIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return !m_pending && !m_busy; });
+}
+
+int AutoSaver::getSavedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_savedCount;
+}
+
+int AutoSaver::getSkippedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_skippedCount;
+}
+
+qint64 AutoSaver::getLastSaveNs() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastSaveNs;
+}
+
+// 后台线程：取出最新的一份写入，退出前写完已提交的存档
+void AutoSaver::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this] { return m_pending || m_stop; });
+        if (!m_pending) {
+            break; // 要求退出且没有待写的存档
+        }
+        std::unique_ptr<SaveGame> save = std::move(m_pending);
+        m_busy = true;
+        lock.unlock();
+
+        QElapsedTimer timer;
+        timer.start();
+        QString error;
+        const bool ok = save->save(m_path, &error);
+        const qint64 elapsed = timer.nsecsElapsed();
+        emit saved(ok, error);
+
+        lock.lock();
+        m_spare = std::move(save); // 留作下一次取状态的缓冲（同时只保留一份）
+        m_busy = false;
+        m_lastSaveNs = elapsed;
+        if (ok) {
+            ++m_savedCount;
+        }
+        if (!m_pending) {
+            m_idle.notify_all();
+        }
+    }
+    m_idle.notify_all();
+}
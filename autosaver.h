@@ -0,0 +1,56 @@
+#ifndef AUTOSAVER_H // 防止头文件重复包含
+#define AUTOSAVER_H
+
+#include <QObject>  // Qt对象基类
+#include <QString>  // Qt字符串类
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "savegame.h" // 游戏存档
+
+// 后台自动存档：调用方在游戏线程取存档副本后submit，立即返回；
+// 序列化与写文件在常驻的后台线程完成，不占用模拟帧的时间。
+// 写完的副本留作下一次取状态的缓冲（takeBuffer），大网格上取状态只是按行复制，不再分配几十MB的新数组。
+// 上一份还没写完时新提交的只保留最新一份（中间的被跳过），写入经QSaveFile完成，中途退出也不会留下半个文件。
+// 每份写完在后台线程发出saved信号，连接到界面对象时自动排队到界面线程。
+class AutoSaver : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AutoSaver(const QString& path, QObject* parent = nullptr);
+    ~AutoSaver(); // 写完已提交的存档再退出
+
+    const QString& getPath() const { return m_path; }
+
+    // 取一份用来复制游戏状态的缓冲（SaveGame::capture）：有上一份写完的就复用它，否则新建
+    std::unique_ptr<SaveGame> takeBuffer();
+    void submit(std::unique_ptr<SaveGame> save); // 交给后台线程写入
+    void submit(SaveGame save);
+    void waitForIdle();          // 等待已提交的存档全部写完
+
+    int getSavedCount() const;   // 累计写入成功的份数
+    int getSkippedCount() const; // 累计被更新的存档替换、没有写入的份数
+    qint64 getLastSaveNs() const; // 上一份的序列化加写入耗时（纳秒）
+
+signals:
+    void saved(bool ok, const QString& error); // 一份存档写完（在后台线程发出）
+
+private:
+    QString m_path;
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake; // 有新的存档或需要退出
+    std::condition_variable m_idle; // 存档全部写完
+    std::unique_ptr<SaveGame> m_pending; // 等待写入的最新一份
+    std::unique_ptr<SaveGame> m_spare;   // 写完留下的缓冲，供下一次takeBuffer复用
+    bool m_busy;
+    bool m_stop;
+    int m_savedCount;
+    int m_skippedCount;
+    qint64 m_lastSaveNs;
+
+    void workerLoop();
+};
+
+#endif // AUTOSAVER_H
@@ -0,0 +1,756 @@
+// 模拟热点的微基准测试套件：在不同网格尺寸、种植密度和藻类组合下测量
+// 光照查询、遮光计算、特性刷新（种植/移除）、网格更新、生产速率汇总、属性查表，
+// 以及线程扩展性、氮碳内核各指令集实现、存档读写（含后台自动存档的提交耗时）和操作录像的解码、跳转与回放。
+//
+// 输出为CSV（默认）或JSON，每行一个测量：ns/op取多轮中的最小值和中位数，
+// allocs/op为每次操作的堆分配次数：glibc下在malloc层统计，含Qt容器的分配；其他C库上只统计全局operator new。
+// 所有随机数据都用固定种子生成，同一版本多次运行的工作量完全相同，可直接对比不同构建。
+//
+// 用法：algaeplus_bench [--format csv|json] [--budget-ms N] [--repeat N] [--max-size N] [--filter 名称片段]
+#include "algaegame.h"       // 游戏主逻辑（生产速率汇总）
+#include "gridmodel.h"       // 网格模型
+#include "nutrientkernel.h"  // 氮碳计算内核
+#include "savegame.h"        // 游戏存档
+#include "autosaver.h"       // 后台自动存档
+#include "replayplayer.h"    // 录像回放
+#include "replayrecorder.h"  // 操作录制器
+#include <QCoreApplication>  // 命令行参数
+#include <QCommandLineParser> // 命令行解析
+#include <QDir>              // 临时目录
+#include <QFile>             // 删除临时存档
+#include <QElapsedTimer>     // 计时器
+#include <QRandomGenerator>  // 随机数生成器
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ---------- 堆分配计数 ----------
+//
+// glibc下在malloc这一层计数：替换malloc/calloc/realloc后，operator new和Qt容器（QArrayData直接调用malloc/realloc）
+// 的分配都会经过这里。其他C库上退回到替换全局operator new，只能数到C++的new，Qt容器的分配数不到。
+
+namespace {
+std::atomic<long long> g_allocations{0};
+}
+
+#if defined(__GLIBC__)
+
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+void __libc_free(void* p);
+
+void* malloc(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+
+void free(void* p)
+{
+    __libc_free(p);
+}
+}
+
+#else
+
+// GCC 11+在替换后的operator delete被内联进标准库容器时会误报new/free不匹配
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+#endif
+
+namespace {
+
+volatile double g_sink = 0.0; // 防止被测调用被优化掉
+
+// 一次测量的配置与结果
+struct Result {
+    std::string benchmark; // 基准名称
+    int rows = 0;          // 网格行数（与网格无关的基准为0）
+    int cols = 0;
+    double density = 0.0;  // 种植密度
+    std::string mix;       // 藻类组合
+    int threads = 1;       // 线程数
+    std::string variant;   // 其他变体（如指令集），没有时为"-"
+    double nsPerOp = 0.0;        // 多轮中最快一轮的每次操作耗时
+    double nsPerOpMedian = 0.0;  // 多轮耗时中位数
+    double allocsPerOp = 0.0;    // 每次操作的堆分配次数
+    qint64 ops = 0;              // 总操作次数
+};
+
+// 测量参数
+struct Settings {
+    qint64 budgetNs = 50000000LL; // 每轮时间预算
+    int repeat = 3;               // 轮数
+    int maxSize = 2048;           // 最大网格边长（线程扩展性测到2048x2048，其余最大1024x1024）
+    QString filter;               // 只运行名称包含该片段的基准
+};
+
+// 按时间预算重复执行op（每次调用op算作opsPerCall次操作），多轮取最小值和中位数
+template <typename Op>
+void measure(const Settings& settings, qint64 opsPerCall, Result& result, Op op)
+{
+    std::vector<double> rounds;
+    long long allocations = 0;
+    qint64 totalOps = 0;
+    for (int round = 0; round < settings.repeat; ++round) {
+        const long long allocBefore = g_allocations.load(std::memory_order_relaxed);
+        QElapsedTimer timer;
+        timer.start();
+        qint64 calls = 0;
+        do {
+            op();
+            ++calls;
+        } while (timer.nsecsElapsed() < settings.budgetNs);
+        const qint64 elapsed = timer.nsecsElapsed();
+        allocations += g_allocations.load(std::memory_order_relaxed) - allocBefore;
+        totalOps += calls * opsPerCall;
+        rounds.push_back(static_cast<double>(elapsed) / (calls * opsPerCall));
+    }
+    std::sort(rounds.begin(), rounds.end());
+    result.nsPerOp = rounds.front();
+    result.nsPerOpMedian = rounds[rounds.size() / 2];
+    result.allocsPerOp = static_cast<double>(allocations) / totalOps;
+    result.ops = totalOps;
+}
+
+// 藻类组合
+struct SpeciesMix {
+    const char* name;
+    std::vector<AlgaeType::Type> types;
+};
+
+// 按密度和组合随机种植（固定种子，结果可复现）
+void populate(GridModel& grid, double density, const SpeciesMix& mix, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+    for (int row = 0; row < grid.getRows(); ++row) {
+        for (int col = 0; col < grid.getCols(); ++col) {
+            if (rng.bounded(1000) < density * 1000) {
+                const AlgaeType::Type type = mix.types[rng.bounded(static_cast<int>(mix.types.size()))];
+                grid.plant(row, col, type, 1e9, true, true); // 基准测试强制种植，忽略光照判定
+            }
+        }
+    }
+    grid.recomputeDirtyProduction();
+}
+
+// 氮碳内核的输入数组（随机数据，覆盖消耗不足、触及上下限和各种状态）
+struct NutrientArrays {
+    std::vector<double> nitrogen, carbon, regenN, regenC, consumeN, consumeC;
+    std::vector<quint8> status;
+
+    NutrientArrays(int count, quint32 seed)
+        : nitrogen(count), carbon(count), regenN(count), regenC(count), consumeN(count), consumeC(count), status(count)
+    {
+        QRandomGenerator rng(seed);
+        for (int k = 0; k < count; ++k) {
+            nitrogen[k] = rng.bounded(3100) / 100.0;
+            carbon[k] = rng.bounded(8100) / 100.0;
+            regenN[k] = rng.bounded(40, 121) / 10.0;
+            regenC[k] = rng.bounded(150, 601) / 10.0;
+            const bool occupied = rng.bounded(10) < 3;
+            consumeN[k] = occupied ? rng.bounded(10, 31) / 10.0 * 100.0 : 0.0; // 放大消耗，使一部分格子资源不足
+            consumeC[k] = occupied ? rng.bounded(50, 181) / 10.0 * 100.0 : 0.0;
+            status[k] = static_cast<quint8>(rng.bounded(4));
+        }
+    }
+
+    void consume(double deltaTime) {
+        NutrientKernel::consume(nitrogen.data(), carbon.data(), status.data(), consumeN.data(), consumeC.data(),
+                                deltaTime, static_cast<int>(nitrogen.size()));
+    }
+    void regenerate(double deltaTime) {
+        NutrientKernel::regenerate(nitrogen.data(), carbon.data(), status.data(), regenN.data(), regenC.data(),
+                                   consumeN.data(), consumeC.data(), deltaTime, static_cast<int>(nitrogen.size()));
+    }
+    bool sameAs(const NutrientArrays& other) const {
+        const size_t bytes = nitrogen.size() * sizeof(double);
+        return std::memcmp(nitrogen.data(), other.nitrogen.data(), bytes) == 0
+            && std::memcmp(carbon.data(), other.carbon.data(), bytes) == 0
+            && status == other.status;
+    }
+};
+
+// 结果输出
+class Reporter {
+public:
+    explicit Reporter(bool json) : m_json(json) {}
+
+    void begin() {
+        if (m_json) {
+            std::printf("{\n  \"context\": {\"hardware_threads\": %u, \"nutrient_isa\": \"%s\"},\n  \"benchmarks\": [\n",
+                        std::thread::hardware_concurrency(), NutrientKernel::isaName(NutrientKernel::bestIsa()));
+        } else {
+            std::printf("benchmark,rows,cols,density,mix,threads,variant,ns_per_op,ns_per_op_median,allocs_per_op,ops\n");
+        }
+    }
+
+    void add(const Result& r) {
+        if (m_json) {
+            std::printf("%s    {\"benchmark\": \"%s\", \"rows\": %d, \"cols\": %d, \"density\": %.2f, \"mix\": \"%s\", "
+                        "\"threads\": %d, \"variant\": \"%s\", \"ns_per_op\": %.3f, \"ns_per_op_median\": %.3f, "
+                        "\"allocs_per_op\": %.6f, \"ops\": %lld}",
+                        m_count > 0 ? ",\n" : "", r.benchmark.c_str(), r.rows, r.cols, r.density, r.mix.c_str(),
+                        r.threads, r.variant.c_str(), r.nsPerOp, r.nsPerOpMedian, r.allocsPerOp, static_cast<long long>(r.ops));
+        } else {
+            std::printf("%s,%d,%d,%.2f,%s,%d,%s,%.3f,%.3f,%.6f,%lld\n",
+                        r.benchmark.c_str(), r.rows, r.cols, r.density, r.mix.c_str(), r.threads, r.variant.c_str(),
+                        r.nsPerOp, r.nsPerOpMedian, r.allocsPerOp, static_cast<long long>(r.ops));
+        }
+        ++m_count;
+        std::fflush(stdout);
+    }
+
+    void end() {
+        if (m_json) {
+            std::printf("\n  ]\n}\n");
+        }
+    }
+
+private:
+    bool m_json;
+    int m_count = 0;
+};
+
+bool selected(const Settings& settings, const char* name)
+{
+    return settings.filter.isEmpty() || QString(name).contains(settings.filter);
+}
+
+// 网格配置下的基准名称
+const char* const kGridBenchmarks[] = {
+    "grid_get_light", "grid_shading", "grid_special_effects", "grid_light_field", "grid_update", "game_production_rates"
+};
+
+// 随机查询坐标（固定种子）
+std::vector<std::pair<int, int>> randomCells(int rows, int cols, int count, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+    std::vector<std::pair<int, int>> cells(count);
+    for (auto& cell : cells) {
+        cell = { rng.bounded(rows), rng.bounded(cols) };
+    }
+    return cells;
+}
+
+// 一个网格配置下的全部网格相关基准
+void runGridBenchmarks(const Settings& settings, Reporter& reporter, int rows, int cols, double density, const SpeciesMix& mix)
+{
+    AlgaeGame game;
+    GridModel* grid = game.getGrid();
+    grid->setCellChangedCallback(nullptr); // 只测网格模型本身；生产速率汇总单独测
+    grid->setThreadCount(1); // 单线程，结果与机器核数无关
+    grid->setResourceSeed(2024u);
+    grid->initialize(rows, cols);
+    populate(*grid, density, mix, 12345u);
+
+    Result base;
+    base.rows = rows;
+    base.cols = cols;
+    base.density = density;
+    base.mix = mix.name;
+    base.variant = "-";
+
+    const int queryCount = 4096;
+    const std::vector<std::pair<int, int>> queries = randomCells(rows, cols, queryCount, 99u);
+
+    if (selected(settings, "grid_get_light")) {
+        Result r = base;
+        r.benchmark = "grid_get_light";
+        measure(settings, queryCount, r, [&] {
+            double sum = 0.0;
+            for (const auto& q : queries) {
+                sum += grid->getLightAt(q.first, q.second);
+            }
+            g_sink = sum;
+        });
+        reporter.add(r);
+    }
+
+    if (selected(settings, "grid_shading")) {
+        Result r = base;
+        r.benchmark = "grid_shading";
+        measure(settings, queryCount, r, [&] {
+            int sum = 0;
+            for (const auto& q : queries) {
+                sum += grid->calculateShadingAt(q.first, q.second);
+            }
+            g_sink = sum;
+        });
+        reporter.add(r);
+    }
+
+    // 特性（原calculateSpecialEffects）只在种植/移除时刷新：每次操作为一次种植加一次移除及其产量重算
+    if (selected(settings, "grid_special_effects")) {
+        std::vector<std::pair<int, int>> emptyCells;
+        for (const auto& q : queries) {
+            if (!grid->isOccupied(q.first, q.second)) {
+                emptyCells.push_back(q);
+            }
+        }
+        if (!emptyCells.empty()) {
+            Result r = base;
+            r.benchmark = "grid_special_effects";
+            size_t next = 0;
+            measure(settings, 1, r, [&] {
+                const auto& cell = emptyCells[next];
+                next = (next + 1) % emptyCells.size();
+                grid->plant(cell.first, cell.second, AlgaeType::TYPE_B, 1e9, true, true);
+                grid->remove(cell.first, cell.second);
+                grid->recomputeDirtyProduction();
+            });
+            reporter.add(r);
+        }
+    }
+
+    if (selected(settings, "grid_light_field")) {
+        Result r = base;
+        r.benchmark = "grid_light_field";
+        std::vector<float> field(static_cast<size_t>(rows) * cols);
+        measure(settings, 1, r, [&] {
+            grid->computeLightField(field.data(), field.size());
+        });
+        reporter.add(r);
+    }
+
+    if (selected(settings, "grid_update")) {
+        Result r = base;
+        r.benchmark = "grid_update";
+        measure(settings, 1, r, [&] {
+            grid->update(AlgaeGame::SIM_STEP);
+        });
+        reporter.add(r);
+    }
+
+    // 生产速率汇总：onGridChanged = 重算标脏格子 + 读取产量合计 + 胜利判定
+    if (selected(settings, "game_production_rates")) {
+        Result r = base;
+        r.benchmark = "game_production_rates";
+        measure(settings, 1, r, [&] {
+            game.onGridChanged();
+        });
+        reporter.add(r);
+    }
+}
+
+// 录一局：每隔随机的步数随机选择藻类、种植或移除，中途重开一次（固定种子，结果可复现）
+void recordSession(AlgaeGame& game, ReplayRecorder& recorder, qint64 ticks, quint32 seed)
+{
+    QRandomGenerator rng(seed);
+    const GridModel* grid = game.getGrid();
+    game.setRecorder(&recorder);
+    game.startGame();
+    bool restarted = false;
+    while (recorder.getTick() < ticks) {
+        game.advance(1 + rng.bounded(40));
+        if (!restarted && recorder.getTick() >= ticks / 2) {
+            game.resetGame();
+            game.startGame();
+            restarted = true;
+        }
+        const int row = rng.bounded(grid->getRows());
+        const int col = rng.bounded(grid->getCols());
+        const int action = rng.bounded(10);
+        if (action < 2) {
+            game.setSelectedAlgaeType(static_cast<AlgaeType::Type>(AlgaeType::TYPE_A + rng.bounded(5)));
+        } else if (action < 8) {
+            game.plantAlgae(row, col);
+        } else {
+            game.removeAlgae(row, col);
+        }
+    }
+    recorder.sync(game);
+    game.setRecorder(nullptr);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("algaeplus 模拟热点微基准测试");
+    parser.addHelpOption();
+    QCommandLineOption formatOption("format", "输出格式：csv（默认）或json", "format", "csv");
+    QCommandLineOption budgetOption("budget-ms", "每轮测量的时间预算（毫秒），默认50", "ms", "50");
+    QCommandLineOption repeatOption("repeat", "每个测量的轮数，默认3", "n", "3");
+    QCommandLineOption maxSizeOption("max-size", "最大网格边长，默认2048", "n", "2048");
+    QCommandLineOption filterOption("filter", "只运行名称包含该片段的基准", "text");
+    parser.addOption(formatOption);
+    parser.addOption(budgetOption);
+    parser.addOption(repeatOption);
+    parser.addOption(maxSizeOption);
+    parser.addOption(filterOption);
+    parser.process(app);
+
+    Settings settings;
+    settings.budgetNs = qMax(1, parser.value(budgetOption).toInt()) * 1000000LL;
+    settings.repeat = qMax(1, parser.value(repeatOption).toInt());
+    settings.maxSize = parser.value(maxSizeOption).toInt();
+    settings.filter = parser.value(filterOption);
+    Reporter reporter(parser.value(formatOption) == "json");
+    reporter.begin();
+
+    // 属性查表：与网格无关
+    if (selected(settings, "type_get_properties")) {
+        Result r;
+        r.benchmark = "type_get_properties";
+        r.mix = "-";
+        r.variant = "-";
+        const int lookups = 1024;
+        measure(settings, lookups, r, [] {
+            double sum = 0.0;
+            for (int k = 0; k < lookups; ++k) {
+                sum += AlgaeType::getProperties(static_cast<AlgaeType::Type>(k % AlgaeType::TYPE_COUNT)).consumeRateN;
+            }
+            g_sink = sum;
+        });
+        reporter.add(r);
+    }
+
+    struct Size { int rows; int cols; };
+    const Size sizes[] = { {10, 8}, {32, 32}, {64, 64}, {128, 128}, {256, 256}, {512, 512}, {1024, 1024} };
+    const double densities[] = { 0.1, 0.3, 0.6 };
+    const SpeciesMix mixes[] = {
+        { "all", { AlgaeType::TYPE_A, AlgaeType::TYPE_B, AlgaeType::TYPE_C, AlgaeType::TYPE_D, AlgaeType::TYPE_E } },
+        { "shade", { AlgaeType::TYPE_A, AlgaeType::TYPE_B } },            // 遮光深、相邻特性多
+        { "light", { AlgaeType::TYPE_C, AlgaeType::TYPE_D, AlgaeType::TYPE_E } }, // 不遮光、E型加光
+    };
+    const bool anyGridBenchmark = std::any_of(std::begin(kGridBenchmarks), std::end(kGridBenchmarks),
+                                              [&settings](const char* name) { return selected(settings, name); });
+    for (const Size& size : sizes) {
+        if (!anyGridBenchmark || size.rows > settings.maxSize || size.cols > settings.maxSize) {
+            continue;
+        }
+        for (double density : densities) {
+            for (const SpeciesMix& mix : mixes) {
+                runGridBenchmarks(settings, reporter, size.rows, size.cols, density, mix);
+            }
+        }
+    }
+
+    // 线程扩展性：1024x1024与2048x2048网格在1、2、4……直到硬件线程数下的单帧耗时（超过--max-size的尺寸跳过）
+    if (selected(settings, "grid_update_threads")) {
+        const int maxThreads = qMax(1u, std::thread::hardware_concurrency());
+        const Size scalingSizes[] = { {1024, 1024}, {2048, 2048} };
+        std::vector<int> threadCounts;
+        for (int threads = 1; threads < maxThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+        for (const Size& size : scalingSizes) {
+            if (size.rows > settings.maxSize || size.cols > settings.maxSize) {
+                continue;
+            }
+            GridModel grid;
+            grid.setResourceSeed(2024u);
+            grid.initialize(size.rows, size.cols);
+            populate(grid, 0.3, mixes[0], 12345u);
+            for (int threads : threadCounts) {
+                grid.setThreadCount(threads);
+                Result r;
+                r.benchmark = "grid_update_threads";
+                r.rows = size.rows;
+                r.cols = size.cols;
+                r.density = 0.3;
+                r.mix = mixes[0].name;
+                r.threads = threads;
+                r.variant = "-";
+                measure(settings, 1, r, [&] {
+                    grid.update(AlgaeGame::SIM_STEP);
+                });
+                reporter.add(r);
+            }
+        }
+    }
+
+    // 氮碳内核：各指令集实现的每格耗时；结果与标量实现不一致时以非零退出
+    int status = 0;
+    if (selected(settings, "nutrient_")) {
+        const int kernelCells = 1 << 20;  // 约100万格，相当于1024x1024网格
+        const int checkPasses = 50;       // 校验时交替执行消耗与恢复的轮数
+        const NutrientKernel::Isa bestIsa = NutrientKernel::bestIsa();
+        NutrientArrays reference(kernelCells, 777u);
+        NutrientKernel::setIsa(NutrientKernel::ISA_SCALAR);
+        for (int pass = 0; pass < checkPasses; ++pass) {
+            reference.consume(0.05);
+            reference.regenerate(0.05);
+        }
+        for (int isa = NutrientKernel::ISA_SCALAR; isa <= bestIsa; ++isa) {
+            NutrientKernel::setIsa(static_cast<NutrientKernel::Isa>(isa));
+            NutrientArrays arrays(kernelCells, 777u);
+            for (int pass = 0; pass < checkPasses; ++pass) {
+                arrays.consume(0.05);
+                arrays.regenerate(0.05);
+            }
+            if (!arrays.sameAs(reference)) {
+                std::fprintf(stderr, "nutrient kernel %s differs from scalar\n", NutrientKernel::isaName(static_cast<NutrientKernel::Isa>(isa)));
+                status = 1;
+            }
+            Result r;
+            r.mix = "-";
+            r.variant = NutrientKernel::isaName(static_cast<NutrientKernel::Isa>(isa));
+            // 计时用极小的步长，数组在多轮之间保持在正常取值范围内
+            r.benchmark = "nutrient_consume";
+            measure(settings, kernelCells, r, [&arrays] { arrays.consume(1e-6); });
+            reporter.add(r);
+            r.benchmark = "nutrient_regenerate";
+            measure(settings, kernelCells, r, [&arrays] { arrays.regenerate(1e-6); });
+            reporter.add(r);
+        }
+        NutrientKernel::setIsa(bestIsa);
+    }
+
+    // 存档：取副本、序列化、写文件、读文件，以及自动存档在调用线程上的提交耗时；
+    // 读档后继续模拟的结果与原游戏不一致时以非零退出
+    if (selected(settings, "save_")) {
+        const Size saveSizes[] = { {10, 8}, {1000, 1000} };
+        const QString path = QDir::temp().filePath("algaeplus_bench.algsave");
+        for (const Size& size : saveSizes) {
+            if (size.rows > settings.maxSize || size.cols > settings.maxSize) {
+                continue;
+            }
+            AlgaeGame game;
+            GridModel* grid = game.getGrid();
+            grid->setThreadCount(1);
+            grid->setResourceSeed(2024u);
+            grid->initialize(size.rows, size.cols);
+            populate(*grid, 0.3, mixes[0], 12345u);
+            game.onGridChanged();
+
+            // 校验：存档读回另一局游戏后状态逐字节相同，且继续模拟若干步后仍然相同
+            const SaveGame original = SaveGame::fromGame(game);
+            QString error;
+            SaveGame loaded;
+            AlgaeGame restored;
+            restored.getGrid()->setThreadCount(1);
+            if (!original.save(path, &error) || !loaded.load(path, &error) || !restored.loadSave(loaded)) {
+                std::fprintf(stderr, "save %dx%d failed: %s\n", size.rows, size.cols, qPrintable(error));
+                status = 1;
+            } else {
+                bool same = SaveGame::fromGame(restored).serialize() == original.serialize();
+                for (int step = 0; step < 20 && same; ++step) {
+                    game.getGrid()->update(AlgaeGame::SIM_STEP);
+                    restored.getGrid()->update(AlgaeGame::SIM_STEP);
+                }
+                same = same && SaveGame::fromGame(restored).serialize() == SaveGame::fromGame(game).serialize();
+                if (!same) {
+                    std::fprintf(stderr, "save %dx%d round trip differs\n", size.rows, size.cols);
+                    status = 1;
+                }
+            }
+
+            Result r;
+            r.rows = size.rows;
+            r.cols = size.cols;
+            r.density = 0.3;
+            r.mix = mixes[0].name;
+            r.variant = "-";
+            const SaveGame save = SaveGame::fromGame(game);
+            if (selected(settings, "save_capture")) {
+                r.benchmark = "save_capture";
+                measure(settings, 1, r, [&] {
+                    g_sink = SaveGame::fromGame(game).grid.nitrogen.size();
+                });
+                reporter.add(r);
+            }
+            if (selected(settings, "save_capture_reuse")) {
+                SaveGame buffer = SaveGame::fromGame(game); // 自动存档复用的缓冲：尺寸不变时只复制
+                r.benchmark = "save_capture_reuse";
+                measure(settings, 1, r, [&] {
+                    buffer.capture(game);
+                    g_sink = buffer.grid.nitrogen.size();
+                });
+                reporter.add(r);
+            }
+            if (selected(settings, "save_serialize")) {
+                r.benchmark = "save_serialize";
+                measure(settings, 1, r, [&] {
+                    g_sink = save.serialize().size();
+                });
+                reporter.add(r);
+            }
+            if (selected(settings, "save_write")) {
+                r.benchmark = "save_write";
+                measure(settings, 1, r, [&] {
+                    g_sink = save.save(path);
+                });
+                reporter.add(r);
+            }
+            if (selected(settings, "save_load")) {
+                save.save(path);
+                r.benchmark = "save_load";
+                measure(settings, 1, r, [&] {
+                    SaveGame copy;
+                    g_sink = copy.load(path);
+                });
+                reporter.add(r);
+                r.benchmark = "save_restore"; // 读文件加恢复到游戏（重算光照、特性与产量）
+                measure(settings, 1, r, [&] {
+                    SaveGame copy;
+                    g_sink = copy.load(path) && restored.loadSave(copy);
+                });
+                reporter.add(r);
+            }
+            // 自动存档：调用线程（界面线程）只负责把状态复制进复用的缓冲并提交，写入在后台线程进行
+            if (selected(settings, "save_autosave_submit")) {
+                AutoSaver saver(path);
+                r.benchmark = "save_autosave_submit";
+                measure(settings, 1, r, [&] {
+                    std::unique_ptr<SaveGame> buffer = saver.takeBuffer();
+                    buffer->capture(game);
+                    saver.submit(std::move(buffer));
+                });
+                saver.waitForIdle();
+                reporter.add(r);
+            }
+        }
+        QFile::remove(path);
+    }
+
+    // 操作录像：解码操作流、随机跳转和从头回放到结束；
+    // 录像读回后回放的结果、跳转与顺序回放的结果与录制时不一致时以非零退出
+    if (selected(settings, "replay_")) {
+        struct Session { int rows; int cols; qint64 ticks; };
+        const Session sessions[] = { {10, 8, 72000}, {128, 128, 6000} }; // 1小时的小网格，5分钟的大网格
+        const QString path = QDir::temp().filePath("algaeplus_bench.algreplay");
+        for (const Session& session : sessions) {
+            if (session.rows > settings.maxSize || session.cols > settings.maxSize) {
+                continue;
+            }
+            AlgaeGame game;
+            game.getGrid()->setThreadCount(1);
+            game.getGrid()->setResourceSeed(2024u);
+            game.resizeGrid(session.rows, session.cols);
+            ReplayRecorder recorder(600); // 30模拟秒一个关键帧
+            recordSession(game, recorder, session.ticks, 4242u);
+
+            ReplayLog log;
+            QString error;
+            if (!recorder.getLog().save(path, &error) || !log.load(path, &error)) {
+                std::fprintf(stderr, "replay %dx%d save/load failed: %s\n", session.rows, session.cols, qPrintable(error));
+                status = 1;
+                continue;
+            }
+            AlgaeGame replayed;
+            replayed.getGrid()->setThreadCount(1);
+            ReplayPlayer player(log, replayed);
+            player.setVerify(true);
+            player.playToEnd();
+            if (player.getDivergedCount() != 0 || player.getMismatchCount() != 0 ||
+                SaveGame::fromGame(replayed).serialize() != SaveGame::fromGame(game).serialize()) {
+                std::fprintf(stderr, "replay %dx%d differs: diverged %d, mismatched %d of %d keyframes\n", session.rows,
+                             session.cols, player.getDivergedCount(), player.getMismatchCount(), player.getVerifiedCount());
+                status = 1;
+            }
+            // 跳转（从关键帧恢复）与从头顺序回放到同一步的结果应当相同
+            const qint64 middle = log.getEndTick() / 3 + 17;
+            AlgaeGame linearGame, seekGame;
+            ReplayPlayer linear(log, linearGame);
+            ReplayPlayer seeker(log, seekGame);
+            linear.advanceTo(middle);
+            seeker.seek(log.getEndTick());
+            seeker.seek(middle);
+            if (SaveGame::fromGame(linearGame).serialize() != SaveGame::fromGame(seekGame).serialize()) {
+                std::fprintf(stderr, "replay %dx%d seek differs from linear playback\n", session.rows, session.cols);
+                status = 1;
+            }
+
+            Result r;
+            r.rows = session.rows;
+            r.cols = session.cols;
+            r.mix = "-";
+            r.variant = "-";
+            if (selected(settings, "replay_decode") && log.getInputCount() > 0) {
+                r.benchmark = "replay_decode"; // 每条操作
+                measure(settings, log.getInputCount(), r, [&] {
+                    ReplayLog::Cursor cursor;
+                    ReplayLog::Event event;
+                    qint64 sum = 0;
+                    while (log.next(cursor, event)) {
+                        sum += event.row;
+                    }
+                    g_sink = sum;
+                });
+                reporter.add(r);
+            }
+            if (selected(settings, "replay_seek")) {
+                r.benchmark = "replay_seek"; // 每次跳转到随机步号
+                QRandomGenerator rng(7u);
+                measure(settings, 1, r, [&] {
+                    seeker.seek(rng.bounded(log.getEndTick() + 1));
+                });
+                reporter.add(r);
+            }
+            if (selected(settings, "replay_play")) {
+                r.benchmark = "replay_play"; // 从头回放到结束，每个模拟步
+                measure(settings, log.getEndTick(), r, [&] {
+                    ReplayPlayer full(log, replayed);
+                    full.playToEnd();
+                });
+                reporter.add(r);
+            }
+        }
+        QFile::remove(path);
+    }
+
+    reporter.end();
+    return status;
+}
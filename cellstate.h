@@ -0,0 +1,49 @@
+#ifndef CELLSTATE_H // 防止头文件重复包含
+#define CELLSTATE_H
+
+#include "algaetype.h" // 藻类类型定义
+
+// 单元格的纯数据状态，不依赖任何控件，由GridModel统一持有和更新
+struct CellState {
+    // 单元格状态枚举
+    enum Status {
+        NORMAL,         // 正常
+        RESOURCE_LOW,   // 资源不足
+        LIGHT_LOW,      // 光照不足
+        DYING           // 濒死
+    };
+
+    // 种植结果枚举
+    enum PlantResult {
+        PLANT_SUCCESS,           // 种植成功
+        PLANT_OCCUPIED,          // 已被占用
+        PLANT_LIGHT_LOW,         // 光照略低
+        PLANT_LIGHT_INSUFFICIENT,// 光照严重不足
+        PLANT_RESOURCE_LOW,      // 资源不足
+        PLANT_RESERVED           // 资源预定
+    };
+
+    AlgaeType::Type type = AlgaeType::NONE; // 当前藻类类型
+    Status status = NORMAL;                 // 当前状态
+
+    double productionMultiplier = 1.0; // 产量倍率
+    double timeSinceLightLow = 0.0;    // 光照低计时（秒）
+
+    double carbProduction = 0.0;   // 糖产量
+    double lipidProduction = 0.0;  // 脂产量
+    double proProduction = 0.0;    // 蛋白产量
+    double vitProduction = 0.0;    // 维生素产量
+
+    // --- 特性状态 ---
+    bool reducedByNeighborA = false;   // A型同类相邻减产
+    bool boostedByNeighborB = false;   // 被B型加速
+    bool reducedByNeighborB = false;   // C型被B型减产
+    bool synergizedByNeighbor = false; // 被D型协同
+    bool synergizingNeighbor = false;  // D型正在协同别人
+    bool lightedByE = false;           // 被E型加光
+
+    bool isOccupied() const { return type != AlgaeType::NONE; } // 是否被占用
+    bool isDying() const { return status == DYING; }            // 是否濒死
+};
+
+#endif // CELLSTATE_H
@@ -0,0 +1,110 @@
+#include "dirtygrid.h" // 网格脏区跟踪头文件
+
+DirtyGrid::DirtyGrid()
+    : m_rows(0)
+    , m_cols(0)
+    , m_dirtyCount(0)
+    , m_lastFrameCells(0)
+    , m_repaintedCells(0)
+    , m_frameCount(0)
+{
+}
+
+void DirtyGrid::resize(int rows, int cols)
+{
+    m_rows = qMax(0, rows);
+    m_cols = qMax(0, cols);
+    const int count = m_rows * m_cols;
+    m_hashes.fill(0, count);
+    m_dirty.fill(0, count);
+    m_known.fill(0, count);
+    m_dirtyCount = 0;
+}
+
+void DirtyGrid::invalidate()
+{
+    m_known.fill(0);
+}
+
+bool DirtyGrid::update(int row, int col, quint64 hash)
+{
+    if (row < 0 || row >= m_rows || col < 0 || col >= m_cols) {
+        return false;
+    }
+    const int index = row * m_cols + col;
+    if (m_known[index] && m_hashes[index] == hash) {
+        return false;
+    }
+    m_hashes[index] = hash;
+    m_known[index] = 1;
+    markDirty(row, col);
+    return true;
+}
+
+void DirtyGrid::markDirty(int row, int col)
+{
+    if (row < 0 || row >= m_rows || col < 0 || col >= m_cols) {
+        return;
+    }
+    char& dirty = m_dirty[row * m_cols + col];
+    if (!dirty) {
+        dirty = 1;
+        ++m_dirtyCount;
+    }
+}
+
+QVector<QRect> DirtyGrid::takeDirtyRects()
+{
+    QVector<QRect> rects;
+    ++m_frameCount;
+    m_lastFrameCells = m_dirtyCount;
+    m_repaintedCells += m_dirtyCount;
+    if (m_dirtyCount == 0) {
+        return rects;
+    }
+
+    // open中是延伸到上一行的矩形（在rects中的下标），本行出现列范围相同的行段时向下延伸
+    QVector<int> open;
+    QVector<int> nextOpen;
+    for (int row = 0; row < m_rows; ++row) {
+        nextOpen.clear();
+        int col = 0;
+        while (col < m_cols) {
+            if (!m_dirty[row * m_cols + col]) {
+                ++col;
+                continue;
+            }
+            const int start = col;
+            while (col < m_cols && m_dirty[row * m_cols + col]) {
+                m_dirty[row * m_cols + col] = 0;
+                ++col;
+            }
+            int merged = -1;
+            for (int index : open) {
+                const QRect& r = rects[index];
+                if (r.left() == start && r.width() == col - start) {
+                    merged = index;
+                    break;
+                }
+            }
+            if (merged >= 0) {
+                rects[merged].setHeight(rects[merged].height() + 1);
+                nextOpen.append(merged);
+            } else {
+                rects.append(QRect(start, row, col - start, 1));
+                nextOpen.append(rects.size() - 1);
+            }
+        }
+        open.swap(nextOpen);
+    }
+    m_dirtyCount = 0;
+    return rects;
+}
+
+quint64 DirtyGrid::mix(quint64 seed, quint64 value)
+{
+    quint64 z = seed + 0x9e3779b97f4a7c15ULL + value;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
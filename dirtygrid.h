@@ -0,0 +1,45 @@
+#ifndef DIRTYGRID_H // 防止头文件重复包含
+#define DIRTYGRID_H
+
+#include <QRect>   // 合并后的脏矩形（格子坐标）
+#include <QVector>
+
+// 网格的脏区跟踪：每个格子记一个外观哈希，只有哈希变化的格子才需要重绘
+//
+// 格子把影响外观的全部输入（藻类、状态、取整后的N/C/L、特性角标、悬浮、遮荫）压缩成一个64位哈希交给update，
+// 与上次记录的不同时才标记为脏；takeDirtyRects把一帧内的脏格子合并成尽量少的矩形
+// （先合并同一行中相邻的格子，再合并上下列范围相同的行段），调用方对每个矩形发一次重绘。
+// 农场稳定运行、画面没有变化时一帧的重绘数为0。只在界面线程使用。
+class DirtyGrid {
+public:
+    DirtyGrid();
+
+    void resize(int rows, int cols); // 重置尺寸，全部格子视为未知，下一帧全部重绘
+    void invalidate();               // 全部格子视为未知（尺寸变化、设备像素比变化等）
+
+    bool update(int row, int col, quint64 hash); // 记录格子外观哈希，变化时标记为脏并返回true
+    void markDirty(int row, int col);            // 不比较哈希，直接标记为脏
+
+    // 取出本帧合并后的脏矩形（x为列，y为行，单位是格子）并清空脏标记
+    QVector<QRect> takeDirtyRects();
+
+    int getLastFrameCells() const { return m_lastFrameCells; } // 上一帧重绘的格子数
+    qint64 getRepaintedCells() const { return m_repaintedCells; } // 累计重绘的格子数
+    int getFrameCount() const { return m_frameCount; }         // 累计调用takeDirtyRects的帧数
+
+    // 把一个值并入哈希（splitmix64混合，相邻取值也能充分打散）
+    static quint64 mix(quint64 seed, quint64 value);
+
+private:
+    int m_rows;
+    int m_cols;
+    QVector<quint64> m_hashes; // 每个格子上次绘制时的外观哈希
+    QVector<char> m_known;     // 哈希是否有效（重置后首帧一律视为变化）
+    QVector<char> m_dirty;     // 本帧是否需要重绘
+    int m_dirtyCount;
+    int m_lastFrameCells;
+    qint64 m_repaintedCells;
+    int m_frameCount;
+};
+
+#endif // DIRTYGRID_H
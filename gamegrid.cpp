@@ -1,636 +1,474 @@
 #include "gamegrid.h" // 游戏网格头文件
-#include <QRandomGenerator> // Qt随机数生成器
-#include <QApplication>     // Qt应用程序类
-#include"mainwindow.h"    // 主窗口头文件
 #include <QPainter>
-#include <vector>
-
-GameGrid::GameGrid(QWidget* parent)
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QLinearGradient>
+#include "algaegame.h"   // 游戏对象（网格模型）
+#include "spritecache.h" // 预缩放精灵缓存
+#include "overlaytext.h" // 叠加文字排版缓存
+
+GameGrid::GameGrid(AlgaeGame* game, QWidget* parent)
     : QWidget(parent)
-    , m_layout(new QGridLayout(this)) // 创建网格布局
-    , m_rows(10)  // 默认行数
-    , m_cols(8)   // 默认列数
-    , m_selectedAlgaeType(AlgaeType::NONE) // 初始无选中藻类
-    , m_produceTimer(0.0) // 产出计时器归零
+    , m_game(game)
+    , m_model(game->getGrid())
+    , m_rows(0)
+    , m_cols(0)
+    , m_pitch(MAX_CELL + SPACING)
+    , m_cellSize(MAX_CELL)
+    , m_hovered(-1, -1)
+    , m_hoverLight(0.0)
+    , m_shadingPreview(false)
 {
-    m_layout->setSpacing(2); // 设置格子间距
-    m_layout->setContentsMargins(2, 2, 2, 2); // 设置边距
-    setLayout(m_layout); // 应用布局
-    initialize(m_rows, m_cols); // 初始化网格
+    setMouseTracking(true);
+    setAttribute(Qt::WA_OpaquePaintEvent); // 每次重绘都完整覆盖重绘区域
+    rebuild(); // 按模型尺寸计算格子布局
 }
 
-void GameGrid::initialize(int rows, int cols)
-{
-    m_rows = rows;
-    m_cols = cols;
-    createCells();        // 创建所有单元格
-    initializeGrid();     // 初始化网格结构
-    initializeResources();// 初始化资源
+GameGrid::~GameGrid() {
 }
 
-void GameGrid::createCells()
+void GameGrid::rebuild()
 {
-    clearCells(); // 先清空原有单元格
-    m_cells.resize(m_rows); // 调整行数
-    for (int row = 0; row < m_rows; ++row) {
-        m_cells[row].resize(m_cols); // 调整列数
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = new AlgaeCell(row, col, this); // 创建单元格
-            m_cells[row][col] = cell;
-            m_layout->addWidget(cell, row, col); // 加入布局
-            if (cell) {
-                connect(cell, &AlgaeCell::cellClicked, this, &GameGrid::onCellClicked); // 连接点击信号
-                connect(cell, &AlgaeCell::cellHovered, this, &GameGrid::onCellHovered); // 连接悬浮信号
-            }
-        }
-    }
+    m_rows = m_model->getRows();
+    m_cols = m_model->getCols();
+    m_hovered = QPoint(-1, -1);
+    m_snapshot.clear();
+    m_dirty.resize(m_rows, m_cols); // 新网格首帧全部重绘
+    updateGeometry();
+    layoutCells();
+    update();
 }
 
-void GameGrid::clearCells()
+// 格子间距取能放下整个网格的最大值（不超过MAX_CELL），网格在画布内居中；
+// 间距小于MIN_PITCH时按MIN_PITCH排布，由外层滚动区域负责滚动
+void GameGrid::layoutCells()
 {
-    for (auto& row : m_cells) {
-        for (auto cell : row) {
-            if (cell) {
-                delete cell;
-            }
+    if (m_rows <= 0 || m_cols <= 0) return;
+    const int availW = width() - 2 * MARGIN + SPACING;
+    const int availH = height() - 2 * MARGIN + SPACING;
+    int pitch = qMin(availW / m_cols, availH / m_rows);
+    pitch = qBound(MIN_PITCH, pitch, MAX_CELL + SPACING);
+    const int spacing = pitch >= 24 ? SPACING : (pitch >= 10 ? 1 : 0);
+    const int cellSize = pitch - spacing;
+    const QPoint origin(qMax(0, (width() - (m_cols * pitch - spacing)) / 2),
+                        qMax(0, (height() - (m_rows * pitch - spacing)) / 2));
+    if (pitch != m_pitch || cellSize != m_cellSize || origin != m_origin) {
+        m_pitch = pitch;
+        m_cellSize = cellSize;
+        m_origin = origin;
+        if (m_cellSize >= BADGE_CELL) {
+            const int spriteSize = m_cellSize - 4;
+            SpriteCache::instance()->prebake(QSize(spriteSize, spriteSize), devicePixelRatioF(),
+                                             (1 << SpriteCache::VARIANT_BRIGHTENED) | (1 << SpriteCache::VARIANT_SHADOW));
         }
+        update();
     }
-    m_cells.clear();
 }
 
-void GameGrid::setSelectedAlgaeType(AlgaeType::Type type)
+QRect GameGrid::cellsIn(const QRect& area) const
 {
-    if (m_selectedAlgaeType != type) {
-        m_selectedAlgaeType = type;
-        updateCursor();      // 更新鼠标指针
-        updateShadingAreas();// 更新遮荫区
-    }
+    if (m_rows <= 0 || m_cols <= 0 || area.isEmpty()) return QRect();
+    if (area.right() < m_origin.x() || area.bottom() < m_origin.y()) return QRect();
+    const int firstCol = qMax(0, (area.left() - m_origin.x()) / m_pitch);
+    const int lastCol = qMin(m_cols - 1, (area.right() - m_origin.x()) / m_pitch);
+    const int firstRow = qMax(0, (area.top() - m_origin.y()) / m_pitch);
+    const int lastRow = qMin(m_rows - 1, (area.bottom() - m_origin.y()) / m_pitch);
+    if (firstCol > lastCol || firstRow > lastRow) return QRect();
+    return QRect(QPoint(firstCol, firstRow), QPoint(lastCol, lastRow));
 }
 
-void GameGrid::updateCursor()
+QRect GameGrid::cellRect(int row, int col) const
 {
-    if (m_selectedAlgaeType != AlgaeType::NONE) {
-        AlgaeType::Properties props = AlgaeType::getProperties(m_selectedAlgaeType);
-        QPixmap cursorPixmap(props.cursorImagePath);
-        if (!cursorPixmap.isNull()) {
-            m_algaeCursor = QCursor(cursorPixmap, -1, -1);
-            setCursor(m_algaeCursor);
-        }
-    } else {
-        setCursor(m_defaultCursor);
-    }
+    return QRect(m_origin.x() + col * m_pitch, m_origin.y() + row * m_pitch, m_cellSize, m_cellSize);
 }
 
-void GameGrid::showShadingArea(int row, int col, bool show)
+QPoint GameGrid::cellAt(const QPoint& pos) const
 {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        AlgaeCell* cell = getCell(row, col);
-        if (cell) {
-            cell->showShadingArea(show);
-        }
-    }
+    const int x = pos.x() - m_origin.x();
+    const int y = pos.y() - m_origin.y();
+    if (x < 0 || y < 0 || m_pitch <= 0) return QPoint(-1, -1);
+    const int col = x / m_pitch;
+    const int row = y / m_pitch;
+    if (row >= m_rows || col >= m_cols) return QPoint(-1, -1);
+    if (x % m_pitch >= m_cellSize || y % m_pitch >= m_cellSize) return QPoint(-1, -1); // 落在间隙上
+    return QPoint(row, col);
 }
 
-void GameGrid::updateShadingAreas()
+QSize GameGrid::sizeHint() const
 {
-    // 清除所有遮荫区域
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            if (m_cells[row][col]) {
-                m_cells[row][col]->showShadingArea(false);
-            }
-        }
-    }
-
-    // 只有主窗口允许预览时才显示遮荫区
-    MainWindow* mw = nullptr;
-    QWidget* w = parentWidget();
-    while (w && !mw) { mw = qobject_cast<MainWindow*>(w); w = w->parentWidget(); }
-    if (!mw || !mw->isShadingPreviewEnabled()) return;
-
-    // 如果有选中的藻类类型，显示遮荫区域
-    if (m_selectedAlgaeType != AlgaeType::NONE) {
-        AlgaeType::Properties props = AlgaeType::getProperties(m_selectedAlgaeType);
-        for (int row = 0; row < m_rows; ++row) {
-            for (int col = 0; col < m_cols; ++col) {
-                if (m_cells[row][col] && m_cells[row][col]->isHovered()) {
-                    // 显示遮荫区域
-                    for (int r = qMax(0, row - props.shadingDepth); 
-                         r <= qMin(m_rows - 1, row + props.shadingDepth); ++r) {
-                        for (int c = qMax(0, col - props.shadingDepth);
-                             c <= qMin(m_cols - 1, col + props.shadingDepth); ++c) {
-                            AlgaeCell* cell = getCell(r, c);
-                            if (cell) {
-                                cell->showShadingArea(true);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+    return QSize(m_cols * (MAX_CELL + SPACING) + 2 * MARGIN, m_rows * (MAX_CELL + SPACING) + 2 * MARGIN);
 }
 
-void GameGrid::onCellClicked(int row, int col)
+// 小网格保持每格至少约50像素（与原来格子控件的最小尺寸一致），大网格逐步缩小到MIN_PITCH
+QSize GameGrid::minimumSizeHint() const
 {
-    if (getCell(row, col))
-        emit cellClicked(row, col); // 发射信号
+    const int side = qMax(1, qMax(m_rows, m_cols));
+    const int pitch = qBound(int(MIN_PITCH), 900 / side, 54);
+    return QSize(m_cols * pitch + 2 * MARGIN, m_rows * pitch + 2 * MARGIN);
 }
 
-void GameGrid::onCellHovered(int row, int col, bool entered)
+void GameGrid::setShadingPreview(bool enabled)
 {
-    if (getCell(row, col))
-        emit cellHovered(row, col, entered); // 发射信号
-    updateShadingAreas(); // 悬浮时刷新遮荫区
-}
-
-GameGrid::~GameGrid() {
-    clearCells();
+    if (m_shadingPreview != enabled) {
+        m_shadingPreview = enabled;
+        checkCells(m_snapshot.getArea()); // 预览只改变遮荫标记，不需要重取快照
+        flush();
+    }
 }
 
-AlgaeCell* GameGrid::getCell(int row, int col) const {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        if (m_cells[row][col])
-            return m_cells[row][col];
-    }
-    return nullptr;
+// 每帧刷新：取可见格子的渲染快照，逐格比较外观哈希，只重绘变化的格子
+void GameGrid::refresh()
+{
+    captureSnapshot(cellsIn(visibleRegion().boundingRect()));
+    checkCells(m_snapshot.getArea());
+    flush();
 }
 
-double GameGrid::getLightAt(int row, int col) const {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        double base = m_baseLight[row] - calculateShadingAt(row, col);
-        // 蓝藻叠加光照
-        int blueAlgaeLight = 0;
-        for (int dr = -1; dr <= 1; ++dr) {
-            for (int dc = -1; dc <= 1; ++dc) {
-                int nr = row + dr, nc = col + dc;
-                if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                    AlgaeCell* cell = m_cells[nr][nc];
-                    if (cell && cell->getType() == AlgaeType::TYPE_E) {
-                        blueAlgaeLight += 4;
-                    }
-                }
-            }
+void GameGrid::refreshCells(const QList<QPoint>& cells)
+{
+    captureSnapshot(cellsIn(visibleRegion().boundingRect()));
+    for (const QPoint& cell : cells) {
+        if (m_snapshot.contains(cell.x(), cell.y())) {
+            m_dirty.update(cell.x(), cell.y(), visualHash(cell.x(), cell.y()));
         }
-        base += blueAlgaeLight;
-        return base;
     }
-    return 0.0;
+    flush();
 }
 
-double GameGrid::getLightAt(int row) const {
-    return getLightAt(row, 0);
-}
-
-double GameGrid::getNitrogenAt(int row, int col) const {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        return m_nitrogen[row][col];
+// 只跟踪快照覆盖的格子；覆盖范围变化后（滚动、缩放）记录的哈希全部作废，
+// 因为范围外的变化没有被跟踪，而新露出的部分已由Qt按快照重绘
+void GameGrid::captureSnapshot(const QRect& cells)
+{
+    if (cells != m_snapshot.getArea()) {
+        m_dirty.invalidate();
     }
-    return 0.0;
+    m_snapshot.capture(*m_game, cells);
+    updateHoverLight();
 }
 
-double GameGrid::getCarbonAt(int row, int col) const {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        return m_carbon[row][col];
+// 悬停格子种下选中藻类后的光照要重算遮荫，只在悬停格子或快照变化时向模型取一次
+void GameGrid::updateHoverLight()
+{
+    const AlgaeType::Type selType = m_snapshot.getSelectedType();
+    m_hoverLight = 0.0;
+    if (selType != AlgaeType::NONE && m_snapshot.contains(m_hovered.x(), m_hovered.y())) {
+        m_hoverLight = m_model->getLightAtIfPlanted(m_hovered.x(), m_hovered.y(), selType);
     }
-    return 0.0;
 }
 
-double GameGrid::getNitrogenRegenRate(int row, int col) const {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        return m_nitrogenRegen[row][col];
+void GameGrid::checkCells(const QRect& cells)
+{
+    for (int row = cells.top(); row <= cells.bottom(); ++row) {
+        for (int col = cells.left(); col <= cells.right(); ++col) {
+            m_dirty.update(row, col, visualHash(row, col));
+        }
     }
-    return 0.0;
 }
 
-double GameGrid::getCarbonRegenRate(int row, int col) const {
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        return m_carbonRegen[row][col];
+// 相邻的脏格子合并成一个矩形，每个矩形发一次重绘
+void GameGrid::flush()
+{
+    for (const QRect& r : m_dirty.takeDirtyRects()) {
+        update(cellRect(r.top(), r.left()).united(cellRect(r.bottom(), r.right())));
     }
-    return 0.0;
 }
 
-// 网格整体更新，每帧调用
-void GameGrid::update(double deltaTime) {
-    // 1. 先消耗局部资源
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (cell->isOccupied()) {
-                AlgaeType::Properties props = AlgaeType::getProperties(cell->getType());
-                double nNeed = props.consumeRateN * deltaTime; // 需要消耗的氮
-                double cNeed = props.consumeRateC * deltaTime; // 需要消耗的碳
-                if (m_nitrogen[row][col] < nNeed || m_carbon[row][col] < cNeed) {
-                    cell->setStatus(AlgaeCell::RESOURCE_LOW); // 资源不足
-                } else {
-                    cell->setStatus(AlgaeCell::NORMAL); // 正常
-                    m_nitrogen[row][col] -= nNeed;
-                    m_carbon[row][col] -= cNeed;
-                }
-            } else {
-                cell->setStatus(AlgaeCell::NORMAL); // 空格子状态正常
-            }
-        }
-    }
-    // 2. 遮光区域可视化（同前）
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            m_cells[row][col]->setShadingVisible(false); // 先全部隐藏
-        }
-    }
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (cell->isOccupied()) {
-                AlgaeType::Properties props = AlgaeType::getProperties(cell->getType());
-                int depth = props.shadingDepth;
-                for (int d = 1; d <= depth; ++d) {
-                    int targetRow = row + d;
-                    if (targetRow < m_rows) {
-                        m_cells[targetRow][col]->setShadingVisible(true); // 下方格子显示遮荫
-                    }
-                }
-            }
-        }
-    }
-    // 2.5. 植株特性逻辑刷新
-    calculateSpecialEffects();
-    // 3. 产出资源逻辑：每10秒产出一次
-    m_produceTimer += deltaTime;
-    if (m_produceTimer >= 10.0) {
-        double totalCarb = 0, totalLipid = 0, totalPro = 0, totalVit = 0;
-        for (int row = 0; row < m_rows; ++row) {
-            for (int col = 0; col < m_cols; ++col) {
-                AlgaeCell* cell = m_cells[row][col];
-                if (cell->isOccupied()) {
-                    if (cell->getStatus() == AlgaeCell::NORMAL || cell->getStatus() == AlgaeCell::RESOURCE_LOW) {
-                        totalCarb += cell->getCarbProduction() * 10.0; // 10秒产量
-                        totalLipid += cell->getLipidProduction() * 10.0;
-                        totalPro += cell->getProProduction() * 10.0;
-                        totalVit += cell->getVitProduction() * 10.0;
-                    }
-                }
-            }
-        }
-        // 通过信号或直接调用GameResources接口加资源（需适配你的架构）
-        emit produceResources(totalCarb, totalLipid, totalPro, totalVit); // 发射产出信号
-        m_produceTimer = 0.0; // 计时器归零
-    }
-    // 4. 更新全局资源
-    emit resourcesChanged(); // 通知UI刷新
-    // 5. 更新所有格子（状态刷新）
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            m_cells[row][col]->update(deltaTime); // 单元格自身刷新
-        }
-    }
-    emit gridChanged(); // 通知网格变化
+// 遮荫标记：快照中已种藻类下方shadingDepth行；预览时再加上悬停格子周围选中藻类的遮荫范围
+bool GameGrid::isShaded(int row, int col) const
+{
+    if (m_snapshot.isShaded(row, col)) return true;
+    const AlgaeType::Type selType = m_snapshot.getSelectedType();
+    if (!m_shadingPreview || selType == AlgaeType::NONE || m_hovered.x() < 0) return false;
+    const int depth = AlgaeType::getProperties(selType).shadingDepth;
+    return qAbs(row - m_hovered.x()) <= depth && qAbs(col - m_hovered.y()) <= depth;
 }
 
-// 重置网格和资源
-void GameGrid::reset() {
-    // Reset all cells
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            m_cells[row][col]->remove(); // 移除所有藻类
-        }
+double GameGrid::displayedLight(int row, int col) const
+{
+    if (m_snapshot.getSelectedType() != AlgaeType::NONE && m_hovered == QPoint(row, col)) {
+        return m_hoverLight;
     }
-
-    // Reset resources
-    initializeResources(); // 重新初始化资源
-
-    emit gridChanged();
-    emit resourcesChanged();
+    return m_snapshot.lightAt(row, col); // 只用格子实际光照
 }
 
-// 计算某格的遮光总量
-int GameGrid::calculateShadingAt(int row, int col) const {
-    int totalShading = 0;
-    // 只考虑本列上方的遮荫
-    for (int r = 0; r < row; ++r) {
-        AlgaeCell* cell = m_cells[r][col];
-        if (cell->isOccupied()) {
-            AlgaeType::Properties props = AlgaeType::getProperties(cell->getType());
-            int distanceRows = row - r;
-            if (distanceRows <= props.shadingDepth) {
-                totalShading += props.shadingAmount;
-                if (cell->getType() == AlgaeType::TYPE_A) {
-                    totalShading += 3; // A型藻类额外遮光
-                }
-            }
-        }
-    }
-    return totalShading;
+GameGrid::PlantTag GameGrid::plantTag(int row, int col) const
+{
+    const AlgaeType::Type selType = m_snapshot.getSelectedType();
+    if (selType == AlgaeType::NONE) return TAG_NONE;
+    const bool lightEnough = m_hovered == QPoint(row, col)
+        ? m_hoverLight >= AlgaeType::getProperties(selType).lightRequiredPlant
+        : m_snapshot.lightEnough(row, col, selType);
+    if (!lightEnough) return TAG_LIGHT_LOW;
+    if (!m_snapshot.canAfford(selType)) return TAG_RESOURCE_LOW;
+    return TAG_PLANTABLE;
 }
 
-// 移除藻类时奖励资源
-void GameGrid::applyRemoveBonus(int row, int col) {
-    // Center cell
-    if (row >= 0 && row < m_rows && col >= 0 && col < m_cols) {
-        m_nitrogen[row][col] += 10;
-        m_carbon[row][col] += 15;
-    }
-
-    // Surrounding 8 cells
-    for (int r = row-1; r <= row+1; r++) {
-        for (int c = col-1; c <= col+1; c++) {
-            if (r >= 0 && r < m_rows && c >= 0 && c < m_cols && (r != row || c != col)) {
-                m_nitrogen[r][c] += 5;
-                m_carbon[r][c] += 10;
-            }
-        }
+// 外观哈希：与paintCell读取的输入一一对应（数值按绘制时的取整），修改绘制内容时要同步修改这里
+quint64 GameGrid::visualHash(int row, int col) const
+{
+    const quint8 badgeTraits = GridModel::TRAIT_REDUCED_BY_A | GridModel::TRAIT_BOOSTED_BY_B | GridModel::TRAIT_REDUCED_BY_B
+                             | GridModel::TRAIT_SYNERGIZED | GridModel::TRAIT_SYNERGIZING;
+    const AlgaeType::Type type = m_snapshot.typeAt(row, col);
+    quint64 h = DirtyGrid::mix(0, type);
+    h = DirtyGrid::mix(h, m_snapshot.statusAt(row, col));
+    h = DirtyGrid::mix(h, m_snapshot.traitsAt(row, col) & badgeTraits);
+    h = DirtyGrid::mix(h, (m_hovered == QPoint(row, col) ? 1 : 0) | (isShaded(row, col) ? 2 : 0));
+    h = DirtyGrid::mix(h, (int)m_snapshot.nitrogenAt(row, col));
+    h = DirtyGrid::mix(h, (int)m_snapshot.carbonAt(row, col));
+    h = DirtyGrid::mix(h, (int)m_snapshot.lightAt(row, col));
+    if (type == AlgaeType::NONE) {
+        h = DirtyGrid::mix(h, (int)displayedLight(row, col));
+        h = DirtyGrid::mix(h, plantTag(row, col));
     }
-
-    emit resourcesChanged();
+    return h;
 }
 
-// 初始化网格结构（重新分配单元格对象）
-void GameGrid::initializeGrid() {
-    m_cells.resize(m_rows);
+void GameGrid::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    layoutCells();
+}
 
-    for (int row = 0; row < m_rows; ++row) {
-        m_cells[row].resize(m_cols);
+void GameGrid::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    const QRect dirty = event->rect();
+    painter.fillRect(dirty, QColor(10, 20, 60)); // 间隙与边距
 
-        for (int col = 0; col < m_cols; ++col) {
-            m_cells[row][col] = new AlgaeCell(row, col, this);
+    // 只画与重绘区域相交的格子，行列范围直接由坐标换算
+    const QRect cells = cellsIn(dirty);
+    if (cells.isEmpty()) return;
 
-            // Connect signals
-            connect(m_cells[row][col], &AlgaeCell::cellChanged, this, [=]() {
-                emit cellChanged(row, col);
-            });
-        }
+    // 滚动露出的格子在下一帧刷新前还不在快照里，先补取一次（只在可见范围变化后发生）
+    if (!m_snapshot.covers(cells)) {
+        captureSnapshot(cellsIn(visibleRegion().boundingRect()).united(cells));
     }
-}
 
-// 初始化资源，包括光照、氮、碳及其恢复速率
-void GameGrid::initializeResources() {
-    // 更陡峭的光照梯度（顶部到下方）
-    m_baseLight.resize(m_rows);
-    m_baseLight[0] = 30;
-    m_baseLight[1] = 28;
-    m_baseLight[2] = 26;
-    m_baseLight[3] = 24;
-    m_baseLight[4] = 22;
-    m_baseLight[5] = 20;
-    m_baseLight[6] = 18;
-    m_baseLight[7] = 16;
-    m_baseLight[8] = 14;
-    m_baseLight[9] = 12;
-
-    // Initialize nitrogen and carbon with random values
-    m_nitrogen.resize(m_rows);
-    m_nitrogenRegen.resize(m_rows);
-    m_carbon.resize(m_rows);
-    m_carbonRegen.resize(m_rows);
-
-    for (int row = 0; row < m_rows; ++row) {
-        m_nitrogen[row].resize(m_cols);
-        m_nitrogenRegen[row].resize(m_cols);
-        m_carbon[row].resize(m_cols);
-        m_carbonRegen[row].resize(m_cols);
-
-        for (int col = 0; col < m_cols; ++col) {
-            // Random initial values
-            m_nitrogen[row][col] = QRandomGenerator::global()->bounded(10, 18); // 10-17
-            m_carbon[row][col] = QRandomGenerator::global()->bounded(30, 46);   // 30-45
-
-            // Random regeneration rates
-            m_nitrogenRegen[row][col] = QRandomGenerator::global()->bounded(40, 61) / 10.0; // 4-6/s
-            m_carbonRegen[row][col] = QRandomGenerator::global()->bounded(150, 301) / 10.0; // 15-30/s
+    painter.setRenderHint(QPainter::Antialiasing, m_cellSize >= BADGE_CELL);
+    const qreal dpr = devicePixelRatioF();
+    for (int row = cells.top(); row <= cells.bottom(); ++row) {
+        for (int col = cells.left(); col <= cells.right(); ++col) {
+            paintCell(painter, dpr, row, col);
         }
     }
 }
 
-// 更新资源（氮、碳）随时间变化
-void GameGrid::updateResources(double deltaTime) {
-    // Update nitrogen and carbon based on regen rates and consumption
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-
-            // Calculate consumption if cell is occupied
-            double nitrogenConsumption = 0;
-            double carbonConsumption = 0;
-
-            if (cell->isOccupied()) {
-                AlgaeType::Properties props = AlgaeType::getProperties(cell->getType());
-                nitrogenConsumption = props.consumeRateN * deltaTime;
-                carbonConsumption = props.consumeRateC * deltaTime;
-
-                // Adjust for cell's status
-                if (cell->getStatus() == AlgaeCell::RESOURCE_LOW ||
-                    cell->getStatus() == AlgaeCell::LIGHT_LOW) {
-                    nitrogenConsumption *= 0.5;
-                    carbonConsumption *= 0.5;
-                }
-            }
-
-            // Apply regeneration and consumption
-            double nitrogenRegen = m_nitrogenRegen[row][col] * deltaTime;
-            double carbonRegen = m_carbonRegen[row][col] * deltaTime;
-
-            m_nitrogen[row][col] = qMin(30.0, m_nitrogen[row][col] + nitrogenRegen - nitrogenConsumption);
-            m_carbon[row][col] = qMin(80.0, m_carbon[row][col] + carbonRegen - carbonConsumption);
-
-            // Ensure values don't go below 0
-            m_nitrogen[row][col] = qMax(0.0, m_nitrogen[row][col]);
-            m_carbon[row][col] = qMax(0.0, m_carbon[row][col]);
-        }
-    }
-
-    emit resourcesChanged();
+// 画一个特性角标：彩色圆底加一个字符
+static void drawBadge(QPainter& painter, const QRect& rect, const QColor& fill, const QString& text, const QColor& textColor)
+{
+    painter.setBrush(fill);
+    painter.setPen(Qt::NoPen);
+    painter.drawEllipse(rect);
+    OverlayText::instance()->draw(painter, OverlayText::STYLE_BADGE, rect, text, textColor);
 }
 
-// 计算特殊效果（如B型藻类提升左右格恢复速率）
-void GameGrid::calculateSpecialEffects() {
-    // Backup original regen rates
-    QVector<QVector<double>> origNitrogenRegen = m_nitrogenRegen;
-    QVector<QVector<double>> origCarbonRegen = m_carbonRegen;
-
-    // 先清空所有特性标记
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (cell) {
-                cell->setReducedByNeighborA(false);
-                cell->setBoostedByNeighborB(false);
-                cell->setReducedByNeighborB(false);
-                cell->setSynergizedByNeighbor(false);
-                cell->setSynergizingNeighbor(false);
-                cell->setLightedByE(false); // 这里不再用此标记做光照加成，仅用于可视化
-            }
+void GameGrid::paintCell(QPainter& painter, qreal dpr, int row, int col) const
+{
+    const AlgaeType::Type type = m_snapshot.typeAt(row, col);
+    const quint8 traits = m_snapshot.traitsAt(row, col);
+    const QRect tile = cellRect(row, col);
+    const QRect inner = tile.adjusted(2, 2, -2, -2); // 藻类图片所在的正方形
+    const bool detail = m_cellSize >= DETAIL_CELL;
+    const bool hovered = m_hovered == QPoint(row, col);
+    OverlayText* overlay = OverlayText::instance();
+    SpriteCache* sprites = SpriteCache::instance();
+
+    // 1. 蓝色渐变背景（格子很小时用纯色）
+    if (m_cellSize >= BADGE_CELL) {
+        QLinearGradient grad(tile.topLeft(), tile.bottomLeft());
+        grad.setColorAt(0.0, QColor(40, 80, 180));
+        grad.setColorAt(1.0, QColor(10, 20, 60));
+        painter.fillRect(tile, grad);
+    } else {
+        painter.fillRect(tile, QColor(25, 50, 120));
+    }
+    // 2. 光照渐变带（底部）
+    const double light = m_snapshot.lightAt(row, col); // 只用格子实际光照
+    if (m_cellSize >= BADGE_CELL) {
+        QRect lightRect(tile.left() + 4, tile.bottom() - 5, tile.width() - 8, 4);
+        int lightVal = qBound(0, static_cast<int>(light), 100);
+        QLinearGradient lightGrad(lightRect.topLeft(), lightRect.topRight());
+        lightGrad.setColorAt(0.0, QColor(120, 180, 255, 40));
+        lightGrad.setColorAt(1.0, QColor(120, 180, 255, 80 + lightVal));
+        painter.setBrush(lightGrad);
+        painter.setPen(Qt::NoPen);
+        painter.drawRect(lightRect);
+        if (detail) {
+            // 图标+文字
+            const QPixmap iconL = sprites->icon(SpriteCache::ICON_LIGHT, 14, dpr);
+            if (!iconL.isNull()) painter.drawPixmap(lightRect.left(), lightRect.top()-2, iconL);
+            overlay->draw(painter, OverlayText::STYLE_LIGHT_BAR, lightRect.adjusted(16,0,0,0),
+                          QString("光:%1").arg(lightVal), Qt::white, Qt::AlignLeft|Qt::AlignVCenter);
         }
     }
-
-    // 遍历所有格子，设置特性
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (!cell) continue;
-            // A型：同类相邻减产
-            if (cell->getType() == AlgaeType::TYPE_A) {
-                bool reduced = false;
-                for (auto [dr, dc] : std::vector<std::pair<int,int>>{{-1,0},{1,0},{0,-1},{0,1}}) {
-                    int nr = row + dr, nc = col + dc;
-                    if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                        if (m_cells[nr][nc]->getType() == AlgaeType::TYPE_A) {
-                            reduced = true;
-                        }
-                    }
-                }
-                cell->setReducedByNeighborA(reduced);
-            }
-            // B型：提升左右格恢复速率
-            if (cell->getType() == AlgaeType::TYPE_B) {
-                // 左右格
-                if (col > 0 && m_cells[row][col-1]->isOccupied())
-                    m_cells[row][col-1]->setBoostedByNeighborB(true);
-                if (col < m_cols-1 && m_cells[row][col+1]->isOccupied())
-                    m_cells[row][col+1]->setBoostedByNeighborB(true);
-            }
-            // C型：与B相邻减产
-            if (cell->getType() == AlgaeType::TYPE_C) {
-                bool reduced = false;
-                for (auto [dr, dc] : std::vector<std::pair<int,int>>{{-1,0},{1,0},{0,-1},{0,1}}) {
-                    int nr = row + dr, nc = col + dc;
-                    if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                        if (m_cells[nr][nc]->getType() == AlgaeType::TYPE_B) {
-                            reduced = true;
-                        }
-                    }
-                }
-                cell->setReducedByNeighborB(reduced);
-            }
-            // D型协同：与A/B/C型相邻时，自己和邻居产量提升20%，可视化标记
-            if (cell->getType() == AlgaeType::TYPE_D) {
-                bool synergized = false;
-                for (auto [dr, dc] : std::vector<std::pair<int,int>>{{-1,0},{1,0},{0,-1},{0,1}}) {
-                    int nr = row + dr, nc = col + dc;
-                    if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                        AlgaeCell* neighbor = m_cells[nr][nc];
-                        if (neighbor->isOccupied() && neighbor->getType() != AlgaeType::TYPE_D) {
-                            neighbor->setSynergizedByNeighbor(true);
-                            cell->setSynergizingNeighbor(true);
-                            synergized = true;
-                        }
-                    }
-                }
-                cell->setSynergizedByNeighbor(synergized); // D型本身也高亮
-            }
-            // E型：为自身及周围8格加光
-            if (cell->getType() == AlgaeType::TYPE_E) {
-                for (int dr = -1; dr <= 1; ++dr) {
-                    for (int dc = -1; dc <= 1; ++dc) {
-                        int nr = row + dr, nc = col + dc;
-                        if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                            m_cells[nr][nc]->setLightedByE(true);
-                        }
-                    }
-                }
+    // 3. 遮光区可视化（半透明蓝灰，强度递减）
+    if (isShaded(row, col)) {
+        int depth = 1 + (row % 3);
+        int alpha = 40 + 30 * (depth-1);
+        painter.fillRect(inner, QColor(60, 80, 120, alpha));
+    }
+    // 4. 藻类图标更亮（投影与提亮后的图片都从精灵缓存取，各一次贴图）
+    if (type != AlgaeType::NONE) {
+        const QPixmap shadow = sprites->sprite(type, inner.size(), dpr, SpriteCache::VARIANT_SHADOW);
+        if (!shadow.isNull()) {
+            const QPixmap bright = sprites->sprite(type, inner.size(), dpr, SpriteCache::VARIANT_BRIGHTENED);
+            // 等比缩放后的图片在格子内居中
+            const QSize drawnSize = bright.size() / bright.devicePixelRatio();
+            const QPoint spritePos(inner.left() + (inner.width() - drawnSize.width()) / 2,
+                                   inner.top() + (inner.height() - drawnSize.height()) / 2);
+            if (m_cellSize >= BADGE_CELL) painter.drawPixmap(spritePos + QPoint(2, 2), shadow);
+            painter.drawPixmap(spritePos, bright);
+            if (m_cellSize >= BADGE_CELL) {
+                painter.setPen(QPen(QColor(220,240,255,220), 4));
+                painter.setBrush(Qt::NoBrush);
+                painter.drawRect(inner.adjusted(3,3,-3,-3));
             }
         }
     }
-
-    // B型提升左右格恢复速率
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (cell->isOccupied()) {
-                // Special rule for Type B: enhance regeneration in adjacent cells
-                if (cell->getType() == AlgaeType::TYPE_B) {
-                    // Left cell
-                    if (col > 0) {
-                        m_nitrogenRegen[row][col-1] = origNitrogenRegen[row][col-1] * 2.0;
-                        m_carbonRegen[row][col-1] = origCarbonRegen[row][col-1] * 2.0;
-                    }
-                    // Right cell
-                    if (col < m_cols-1) {
-                        m_nitrogenRegen[row][col+1] = origNitrogenRegen[row][col+1] * 2.0;
-                        m_carbonRegen[row][col+1] = origCarbonRegen[row][col+1] * 2.0;
-                    }
-                }
-            }
+    // 顶部中央：藻类状态（仅种植后显示）
+    if (detail && type != AlgaeType::NONE) {
+        QString statusText;
+        QColor statusColor;
+        switch (m_snapshot.statusAt(row, col)) {
+            case CellState::NORMAL: statusText = "正常"; statusColor = QColor(0,255,0); break;
+            case CellState::RESOURCE_LOW: statusText = "资源低"; statusColor = QColor(255,165,0); break;
+            case CellState::LIGHT_LOW: statusText = "光照低"; statusColor = QColor(255,0,0); break;
+            case CellState::DYING: statusText = "濒死"; statusColor = QColor(255,0,128); break;
         }
+        QRect topRect(inner.left(), inner.top(), inner.width(), 22);
+        // 状态图标+文字
+        const QPixmap iconS = sprites->icon(SpriteCache::ICON_STATUS, 16, dpr);
+        if (!iconS.isNull()) painter.drawPixmap(topRect.left(), topRect.top()+2, iconS);
+        overlay->draw(painter, OverlayText::STYLE_STATUS, topRect.adjusted(18,0,0,0), statusText, statusColor,
+                      Qt::AlignLeft|Qt::AlignVCenter);
     }
-    // --- 再统一补一遍E型加光，防止被覆盖 ---
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (cell && cell->getType() == AlgaeType::TYPE_E) {
-                for (int dr = -1; dr <= 1; ++dr) {
-                    for (int dc = -1; dc <= 1; ++dc) {
-                        int nr = row + dr, nc = col + dc;
-                        if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                            m_cells[nr][nc]->setLightedByE(true);
-                        }
-                    }
-                }
-            }
+    // 中央：未种植资源/可否种植标签（更显著）
+    if (detail && type == AlgaeType::NONE) {
+        double n = m_snapshot.nitrogenAt(row, col);
+        double c = m_snapshot.carbonAt(row, col);
+        double l = displayedLight(row, col);
+        // 图标+文字
+        const QPixmap iconN = sprites->icon(SpriteCache::ICON_NITROGEN, 14, dpr);
+        const QPixmap iconC = sprites->icon(SpriteCache::ICON_CARBON, 14, dpr);
+        const QPixmap iconL = sprites->icon(SpriteCache::ICON_LIGHT, 14, dpr);
+        int iconY = inner.top()+inner.height()/2-18;
+        int iconX = inner.left()+12;
+        painter.drawPixmap(iconX, iconY, iconN);
+        overlay->draw(painter, OverlayText::STYLE_LIGHT_BAR, QRect(iconX+16, iconY, 24, 14), QString::number((int)n),
+                      Qt::white, Qt::AlignLeft|Qt::AlignVCenter);
+        painter.drawPixmap(iconX+40, iconY, iconC);
+        overlay->draw(painter, OverlayText::STYLE_LIGHT_BAR, QRect(iconX+56, iconY, 24, 14), QString::number((int)c),
+                      Qt::white, Qt::AlignLeft|Qt::AlignVCenter);
+        painter.drawPixmap(iconX+80, iconY, iconL);
+        overlay->draw(painter, OverlayText::STYLE_LIGHT_BAR, QRect(iconX+96, iconY, 24, 14), QString::number((int)l),
+                      Qt::white, Qt::AlignLeft|Qt::AlignVCenter);
+        // 状态标签
+        QString statusTag;
+        QColor statusColor = Qt::white;
+        switch (plantTag(row, col)) {
+            case TAG_LIGHT_LOW: statusTag = "光照不足"; statusColor = QColor(255,0,0); break;
+            case TAG_RESOURCE_LOW: statusTag = "资源不足"; statusColor = QColor(255,165,0); break;
+            case TAG_PLANTABLE: statusTag = "可种植"; statusColor = QColor(0,255,0); break;
+            case TAG_NONE: break;
+        }
+        QRect tagRect(inner.left()+8, inner.top()+inner.height()/2+8, inner.width()-16, 28);
+        if (!statusTag.isEmpty()) {
+            QColor bg = statusColor; bg.setAlpha(120);
+            painter.setBrush(bg);
+            painter.setPen(Qt::NoPen);
+            painter.drawRoundedRect(tagRect, 8, 8);
+            overlay->draw(painter, OverlayText::STYLE_TAG, tagRect, statusTag, statusColor.darker(180));
         }
     }
-    // --- 蓝藻光照特性可视化（不再影响光照计算，仅用于格子高亮） ---
-    for (int row = 0; row < m_rows; ++row) {
-        for (int col = 0; col < m_cols; ++col) {
-            AlgaeCell* cell = m_cells[row][col];
-            if (cell && cell->getType() == AlgaeType::TYPE_E) {
-                for (int dr = -1; dr <= 1; ++dr) {
-                    for (int dc = -1; dc <= 1; ++dc) {
-                        int nr = row + dr, nc = col + dc;
-                        if (nr >= 0 && nr < m_rows && nc >= 0 && nc < m_cols) {
-                            m_cells[nr][nc]->setLightedByE(true);
-                        }
-                    }
-                }
-            }
+    if (hovered) {
+        painter.setPen(QPen(QColor(255, 255, 0, 180), m_cellSize >= BADGE_CELL ? 6 : 2, Qt::SolidLine));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(inner.adjusted(2, 2, -2, -2));
+        painter.fillRect(inner.adjusted(6, 6, -6, -6), QColor(255, 255, 180, 100));
+    }
+    if (m_cellSize >= BADGE_CELL) {
+        painter.setPen(QPen(Qt::darkBlue, 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(tile.adjusted(0, 0, -1, -1));
+    }
+    if (detail) {
+        overlay->draw(painter, OverlayText::STYLE_COORD, tile.adjusted(2, 2, -2, -2),
+                      QString::number(row) + "," + QString::number(col), Qt::darkGray, Qt::AlignTop | Qt::AlignLeft);
+
+        // 5. 格子下方的资源标注：第一行N、C（8号加粗），第二行L（10号加粗）
+        QRect outRect1(tile.left(), tile.bottom() - 44, tile.width(), 12);
+        QRect outRect2(tile.left(), tile.bottom() - 28, tile.width(), 16);
+        overlay->draw(painter, OverlayText::STYLE_RESOURCE, outRect1,
+                      QString("N:%1 C:%2").arg((int)m_snapshot.nitrogenAt(row, col)).arg((int)m_snapshot.carbonAt(row, col)), Qt::white);
+        overlay->draw(painter, OverlayText::STYLE_LIGHT, outRect2, QString("L:%1").arg((int)light), Qt::white);
+    }
+
+    // --- 藻类特性可视化 ---
+    if (m_cellSize >= BADGE_CELL) {
+        const int r = 18;
+        // A型相邻减产：左上角红色圆底白色粗体"-"
+        if (type == AlgaeType::TYPE_A && (traits & GridModel::TRAIT_REDUCED_BY_A)) {
+            drawBadge(painter, QRect(inner.left()+2, inner.top()+2, r, r), QColor(220,0,0), "-", Qt::white);
+        }
+        // B型被加速：右上角绿色圆底白色粗体"+"
+        if (traits & GridModel::TRAIT_BOOSTED_BY_B) {
+            drawBadge(painter, QRect(inner.right()-r-2, inner.top()+2, r, r), QColor(0,180,0), "+", Qt::white);
+        }
+        // C型被B减产：右下角黄色圆底黑色粗体"!"
+        if (type == AlgaeType::TYPE_C && (traits & GridModel::TRAIT_REDUCED_BY_B)) {
+            drawBadge(painter, QRect(inner.right()-r-2, inner.bottom()-r-2, r, r), QColor(255,220,0), "!", Qt::black);
+        }
+        // D型被协同：左下角蓝色圆底白色粗体"★"
+        if (type == AlgaeType::TYPE_D && (traits & GridModel::TRAIT_SYNERGIZING)) {
+            drawBadge(painter, QRect(inner.left()+2, inner.bottom()-r-2, r, r), QColor(0,120,255), "★", Qt::white);
+        }
+        // 被D型协同的A/B/C型：右下角蓝色圆底白色粗体"↑"
+        if ((traits & GridModel::TRAIT_SYNERGIZED) && type != AlgaeType::TYPE_D) {
+            drawBadge(painter, QRect(inner.right()-r-2, inner.bottom()-r-2, r, r), QColor(0,120,255), "↑", Qt::white);
         }
     }
 }
 
-// 预判种植后某格的光照强度
-double GameGrid::getLightAtIfPlanted(int row, int col, AlgaeType::Type type) const {
-    int simulatedShading = calculateShadingAt(row, col); // 现有遮光
-    if (type != AlgaeType::NONE) {
-        AlgaeType::Properties props = AlgaeType::getProperties(type);
-        for (int d = 1; d <= props.shadingDepth; ++d) {
-            int targetRow = row + d;
-            if (targetRow < m_rows) {
-                simulatedShading += props.shadingAmount; // 预加新藻类遮光
-            }
+void GameGrid::setHovered(const QPoint& cell)
+{
+    if (cell == m_hovered) return;
+    const QPoint previous = m_hovered;
+    m_hovered = cell;
+    if (previous.x() >= 0) emit cellHovered(previous.x(), previous.y(), false);
+    if (cell.x() >= 0) emit cellHovered(cell.x(), cell.y(), true);
+    updateHoverLight();
+    if (m_shadingPreview) {
+        checkCells(m_snapshot.getArea()); // 预览范围随悬停格子移动
+    } else {
+        for (const QPoint& p : { previous, cell }) {
+            if (m_snapshot.contains(p.x(), p.y())) m_dirty.update(p.x(), p.y(), visualHash(p.x(), p.y()));
         }
     }
-    return m_baseLight[row] - simulatedShading; // 返回预判光照
+    flush();
+}
+
+void GameGrid::mousePressEvent(QMouseEvent* event)
+{
+    const QPoint cell = cellAt(event->pos());
+    if (cell.x() < 0) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    if (event->button() == Qt::LeftButton) {
+        emit cellClicked(cell.x(), cell.y());
+    } else if (event->button() == Qt::RightButton) {
+        emit cellRightClicked(cell.x(), cell.y());
+    }
 }
 
-void GameGrid::paintEvent(QPaintEvent* event) {
-    QWidget::paintEvent(event);
+void GameGrid::mouseMoveEvent(QMouseEvent* event)
+{
+    setHovered(cellAt(event->pos()));
+    QWidget::mouseMoveEvent(event);
+}
 
-    QPainter painter(this);
-    QRect rect = this->rect();
-
-    // N、C行
-    QRect outRect1(rect.left(), rect.bottom() - 38, rect.width(), 12);
-    QFont fontNC("Arial", 8, QFont::Bold);
-    painter.setFont(fontNC);
-    QString ncText = QString("<span style='color:#fff;'>N:%1&nbsp;&nbsp;C:%2</span>")
-                        .arg((int)m_nitrogen[0][0]).arg((int)m_carbon[0][0]);
-    QTextDocument docNC;
-    docNC.setHtml(QString("<div align='center' style='line-height:12px;margin:0;padding:0;'>%1</div>").arg(ncText));
-    painter.save();
-    painter.translate(outRect1.left(), outRect1.top());
-    docNC.setTextWidth(outRect1.width());
-    docNC.drawContents(&painter, QRectF(0, 0, outRect1.width(), outRect1.height()));
-    painter.restore();
-
-    // L行
-    QRect outRect2(rect.left(), rect.bottom() - 24, rect.width(), 16);
-    QFont fontL("Arial", 11, QFont::Bold);
-    painter.setFont(fontL);
-    QString lText = QString("<span style='color:#00ff66;'>L:%1</span>").arg((int)getLightAt(0)); // 绿色高亮
-    QTextDocument docL;
-    docL.setHtml(QString("<div align='center' style='line-height:15px;margin:0;padding:0;'>%1</div>").arg(lText));
-    painter.save();
-    painter.translate(outRect2.left(), outRect2.top());
-    docL.setTextWidth(outRect2.width());
-    docL.drawContents(&painter, QRectF(0, 0, outRect2.width(), outRect2.height()));
-    painter.restore();
+void GameGrid::leaveEvent(QEvent* event)
+{
+    setHovered(QPoint(-1, -1));
+    QWidget::leaveEvent(event);
 }
@@ -2,98 +2,111 @@
 #define GAMEGRID_H
 
 #include <QWidget>
-#include <QGridLayout>
-#include <vector>
-#include "algaecell.h"
+#include <QPoint>
+#include <QVector>
+#include <QList>
 #include "algaetype.h"
-
-// 游戏网格类，继承自QWidget
+#include "gridmodel.h"
+#include "dirtygrid.h" // 网格脏区跟踪
+#include "rendersnapshot.h" // 每帧渲染快照
+
+class AlgaeGame;
+class QPainter;
+
+// 游戏网格画布：GridModel的视图，只负责显示与交互
+//
+// 整个网格是一个控件，所有格子在同一次paintEvent中画出，只画与重绘区域相交的格子；
+// 鼠标命中按格子间距直接换算行列，不再为每个格子创建子控件。
+// 格子小到放不下文字时逐级省略文字与角标（细节分级），超大网格放进滚动区域也能流畅滚动与刷新。
+// 每帧刷新时把可见格子的数据取成一份RenderSnapshot，绘制、外观哈希与悬浮提示都只读快照，不再逐格调用模型。
 class GameGrid : public QWidget {
     Q_OBJECT
 
 public:
-    explicit GameGrid(QWidget* parent = nullptr);
+    static const int MARGIN = 10;       // 画布边距
+    static const int SPACING = 4;       // 格子间距（格子较小时自动缩小）
+    static const int MAX_CELL = 80;     // 格子最大边长
+    static const int MIN_PITCH = 6;     // 格子最小间距（再小就出现滚动条）
+    static const int DETAIL_CELL = 48;  // 格子不小于该边长时画全部文字
+    static const int BADGE_CELL = 24;   // 格子不小于该边长时画特性角标
+
+    explicit GameGrid(AlgaeGame* game, QWidget* parent = nullptr);
     ~GameGrid();
 
-    void initialize(int rows, int cols);
-    void update(double deltaTime);
-    void reset();
-
-    AlgaeCell* getCell(int row, int col) const;
-    bool plantAlgae(int row, int col, AlgaeType::Type type);
-    void removeAlgae(int row, int col);
-
-    // 新增：鼠标交互相关方法
-    void setSelectedAlgaeType(AlgaeType::Type type);
-    AlgaeType::Type getSelectedAlgaeType() const { return m_selectedAlgaeType; }
-    void updateCursor();
-    void showShadingArea(int row, int col, bool show);
+    GridModel* model() const { return m_model; } // 对应的网格模型
+    void rebuild(); // 模型尺寸变化后重新计算格子布局
 
     // Grid properties
-    int getRows() const { return m_rows; }
-    int getCols() const { return m_cols; }
-
-    // Light and resources
-    double getLightAt(int row) const;
-    double getLightAt(int row, int col) const;
-    double getNitrogenAt(int row, int col) const;
-    double getCarbonAt(int row, int col) const;
-    double getNitrogenRegenRate(int row, int col) const;
-    double getCarbonRegenRate(int row, int col) const;
-
-    // Calculate combined effects
-    int calculateShadingAt(int row, int col) const;
-    void applyRemoveBonus(int row, int col);
-
-    // 新增：悬浮预判种植后光照
-    double getLightAtIfPlanted(int row, int col, AlgaeType::Type type) const;
-
-    // 新增：每10秒产出一次的计时器
-    double m_produceTimer;
+    int getRows() const { return m_model->getRows(); }
+    int getCols() const { return m_model->getCols(); }
+
+    // Light and resources（转发至GridModel）
+    double getLightAt(int row) const { return m_model->getLightAt(row); }
+    double getLightAt(int row, int col) const { return m_model->getLightAt(row, col); }
+    double getNitrogenAt(int row, int col) const { return m_model->getNitrogenAt(row, col); }
+    double getCarbonAt(int row, int col) const { return m_model->getCarbonAt(row, col); }
+    double getNitrogenRegenRate(int row, int col) const { return m_model->getNitrogenRegenRate(row, col); }
+    double getCarbonRegenRate(int row, int col) const { return m_model->getCarbonRegenRate(row, col); }
+    int calculateShadingAt(int row, int col) const { return m_model->calculateShadingAt(row, col); }
+    double getLightAtIfPlanted(int row, int col, AlgaeType::Type type) const { return m_model->getLightAtIfPlanted(row, col, type); }
+
+    // 格子几何（画布坐标）
+    QRect cellRect(int row, int col) const;
+    QPoint cellAt(const QPoint& pos) const; // 命中的格子（x为行，y为列），落在间隙或网格外时为(-1,-1)
+    QPoint getHoveredCell() const { return m_hovered; }
+
+    void setShadingPreview(bool enabled); // 悬停格子周围的遮荫预览（按住Shift/空格）
+    const RenderSnapshot& snapshot() const { return m_snapshot; } // 本帧的渲染快照（覆盖可见格子）
+    int getLastFrameCells() const { return m_dirty.getLastFrameCells(); } // 上一帧重绘的格子数
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+public slots:
+    void refresh(); // 每帧重取渲染快照，只重绘外观变化的格子
+    void refreshCells(const QList<QPoint>& cells); // 重取渲染快照，只检查指定格子（x为行，y为列）
 
 signals:
-    void cellChanged(int row, int col);
-    void algaePlanted(int row, int col, AlgaeType::Type type);
-    void algaeRemoved(int row, int col);
-    void gridChanged();
-    void resourcesChanged();
-    void gridUpdated();
-    void cellClicked(int row, int col);
+    void cellClicked(int row, int col);      // 左键点击
+    void cellRightClicked(int row, int col); // 右键点击
     void cellHovered(int row, int col, bool entered);
-    // 新增：每10秒产出一次的信号
-    void produceResources(double carb, double lipid, double pro, double vit);
 
-private slots:
-    void onCellClicked(int row, int col);
-    void onCellHovered(int row, int col, bool entered);
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
 
 private:
-    QGridLayout* m_layout;
-    std::vector<std::vector<AlgaeCell*>> m_cells;
+    // 未种植格子上的种植提示
+    enum PlantTag { TAG_NONE, TAG_LIGHT_LOW, TAG_RESOURCE_LOW, TAG_PLANTABLE };
+
+    AlgaeGame* m_game;
+    GridModel* m_model;
     int m_rows;
     int m_cols;
-
-    // 新增：鼠标交互相关属性
-    AlgaeType::Type m_selectedAlgaeType;
-    QCursor m_defaultCursor;
-    QCursor m_algaeCursor;
-
-    QVector<double> m_baseLight;
-    QVector<QVector<double>> m_nitrogen;
-    QVector<QVector<double>> m_nitrogenRegen;
-    QVector<QVector<double>> m_carbon;
-    QVector<QVector<double>> m_carbonRegen;
-
-    void createCells();
-    void clearCells();
-    void updateShadingAreas();
-    void initializeGrid();
-    void initializeResources();
-    void updateResources(double deltaTime);
-    void calculateSpecialEffects();
-
-protected:
-    void paintEvent(QPaintEvent* event) override;
+    int m_pitch;     // 格子间距（边长+间隙）
+    int m_cellSize;  // 格子边长
+    QPoint m_origin; // 左上角格子的位置
+    QPoint m_hovered;          // 悬停的格子（x为行，y为列），无则为(-1,-1)
+    double m_hoverLight;       // 选中藻类种在悬停格子后的光照（悬停或快照变化时取一次）
+    bool m_shadingPreview;     // 是否显示悬停预览
+    DirtyGrid m_dirty;         // 格子外观哈希（只跟踪快照覆盖的格子）
+    RenderSnapshot m_snapshot; // 本帧的渲染快照
+
+    void layoutCells();    // 按当前尺寸计算格子间距与位置
+    QRect cellsIn(const QRect& area) const; // 与区域相交的格子范围（x为列，y为行），无则为空矩形
+    void captureSnapshot(const QRect& cells); // 取cells范围的快照，范围变化时记录的哈希全部作废
+    void updateHoverLight();
+    void checkCells(const QRect& cells); // 逐格比较外观哈希（x为列，y为行）
+    void flush();          // 合并本帧的脏格子并重绘
+    void setHovered(const QPoint& cell);
+    bool isShaded(int row, int col) const;        // 已种藻类的遮荫或悬停预览的遮荫
+    double displayedLight(int row, int col) const; // 格子上显示的光照（悬停时为种下后的光照）
+    PlantTag plantTag(int row, int col) const;     // 选中藻类能否种在该格
+    quint64 visualHash(int row, int col) const;    // 格子外观哈希
+    void paintCell(QPainter& painter, qreal dpr, int row, int col) const;
 };
 
 #endif // GAMEGRID_H
@@ -86,6 +86,26 @@ void GameResources::setVitRate(double rate) {
     }
 }
 
+// 一次设置四种生产速率
+void GameResources::setRates(double carb, double lipid, double pro, double vit) {
+    if (m_carbRate != carb || m_lipidRate != lipid || m_proRate != pro || m_vitRate != vit) {
+        m_carbRate = carb;
+        m_lipidRate = lipid;
+        m_proRate = pro;
+        m_vitRate = vit;
+        emit productionRatesChanged();
+    }
+}
+
+// 一次设置四种资源量
+void GameResources::setAmounts(double carb, double lipid, double pro, double vit) {
+    m_carbohydrates = carb;
+    m_lipids = lipid;
+    m_proteins = pro;
+    m_vitamins = vit;
+    emit resourcesChanged();
+}
+
 // 随时间增量更新资源
 void GameResources::update(double deltaTime) {
     // 按当前生产速率增加资源
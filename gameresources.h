@@ -39,6 +39,8 @@ public:
     void setLipidRate(double rate);  // 设置脂质速率
     void setProRate(double rate);    // 设置蛋白质速率
     void setVitRate(double rate);    // 设置维生素速率
+    void setRates(double carb, double lipid, double pro, double vit); // 一次设置四种速率，有变化时只发一次信号
+    void setAmounts(double carb, double lipid, double pro, double vit); // 一次设置四种资源量（读档用），发一次信号
 
     // 游戏状态相关
     void update(double deltaTime); // 随时间更新资源
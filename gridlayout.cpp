@@ -0,0 +1,144 @@
+#include "gridlayout.h" // 网格布局头文件
+#include <QFile>        // 文件读写
+#include <QTextStream>  // 文本流
+#include "gridmodel.h"  // 网格模型
+
+void GridLayout::resize(int newRows, int newCols) {
+    rows = newRows;
+    cols = newCols;
+    cells.assign(static_cast<size_t>(rows) * cols, AlgaeType::NONE);
+}
+
+std::vector<int> GridLayout::plantingOrder() const {
+    std::vector<int> order;
+    for (bool lightersFirst : { true, false }) {
+        for (int row = rows - 1; row >= 0; --row) {
+            for (int col = 0; col < cols; ++col) {
+                const AlgaeType::Type type = at(row, col);
+                if (type != AlgaeType::NONE && (type == AlgaeType::TYPE_E) == lightersFirst) {
+                    order.push_back(row * cols + col);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+GridLayout GridLayout::fromGrid(const GridModel& grid) {
+    GridLayout layout;
+    layout.seed = grid.getResourceSeed();
+    layout.resize(grid.getRows(), grid.getCols());
+    for (int row = 0; row < layout.rows; ++row) {
+        for (int col = 0; col < layout.cols; ++col) {
+            layout.set(row, col, grid.getTypeAt(row, col));
+        }
+    }
+    return layout;
+}
+
+char GridLayout::typeToChar(AlgaeType::Type type) {
+    if (type > AlgaeType::NONE && type < AlgaeType::TYPE_COUNT) {
+        return static_cast<char>('A' + (type - AlgaeType::TYPE_A));
+    }
+    return '.';
+}
+
+bool GridLayout::charToType(char ch, AlgaeType::Type& type) {
+    if (ch == '.') {
+        type = AlgaeType::NONE;
+        return true;
+    }
+    const int offset = ch - 'A';
+    if (offset >= 0 && offset < AlgaeType::TYPE_COUNT - 1) {
+        type = static_cast<AlgaeType::Type>(AlgaeType::TYPE_A + offset);
+        return true;
+    }
+    return false;
+}
+
+// 读取布局文件
+bool GridLayout::load(const QString& path, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+
+    std::vector<QString> gridLines;
+    quint32 fileSeed = 0;
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        if (line.startsWith("seed")) {
+            bool ok = false;
+            fileSeed = line.mid(4).trimmed().toUInt(&ok);
+            if (!ok) {
+                if (error) {
+                    *error = QString("第%1行：种子无效").arg(lineNumber);
+                }
+                return false;
+            }
+            continue;
+        }
+        if (!gridLines.empty() && line.size() != gridLines.front().size()) {
+            if (error) {
+                *error = QString("第%1行：列数与第一行不一致").arg(lineNumber);
+            }
+            return false;
+        }
+        gridLines.push_back(line);
+    }
+    if (gridLines.empty()) {
+        if (error) {
+            *error = "布局为空";
+        }
+        return false;
+    }
+
+    GridLayout layout;
+    layout.seed = fileSeed;
+    layout.resize(static_cast<int>(gridLines.size()), static_cast<int>(gridLines.front().size()));
+    for (int row = 0; row < layout.rows; ++row) {
+        const QByteArray chars = gridLines[row].toLatin1();
+        for (int col = 0; col < layout.cols; ++col) {
+            AlgaeType::Type type;
+            if (!charToType(chars[col], type)) {
+                if (error) {
+                    *error = QString("第%1个网格行第%2列：无法识别的字符").arg(row + 1).arg(col + 1);
+                }
+                return false;
+            }
+            layout.set(row, col, type);
+        }
+    }
+    *this = layout;
+    return true;
+}
+
+// 写出布局文件
+bool GridLayout::save(const QString& path, QString* error) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    QTextStream out(&file);
+    out << "seed " << seed << "\n";
+    for (int row = 0; row < rows; ++row) {
+        QString line;
+        for (int col = 0; col < cols; ++col) {
+            line += QLatin1Char(typeToChar(at(row, col)));
+        }
+        out << line << "\n";
+    }
+    return true;
+}
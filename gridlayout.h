@@ -0,0 +1,44 @@
+#ifndef GRIDLAYOUT_H // 防止头文件重复包含
+#define GRIDLAYOUT_H
+
+#include <QString>   // Qt字符串类
+#include <vector>
+#include "algaetype.h" // 藻类类型定义
+
+class GridModel;
+
+// 网格布局：每格的藻类类型加上资源随机种子，可从文本文件读写（只依赖QtCore）
+//
+// 文件格式：每行一个网格行，每个字符一格，'.'为空，A~E为对应藻类；
+// "seed N"行给出资源随机种子（缺省为0），'#'开头的行为注释，空行忽略。
+//   # 示例
+//   seed 42
+//   A.B.C.D.
+//   ........
+struct GridLayout {
+    int rows = 0;
+    int cols = 0;
+    quint32 seed = 0;                   // 资源随机种子（GridModel::setResourceSeed）
+    std::vector<AlgaeType::Type> cells; // 行优先，共rows*cols格
+
+    AlgaeType::Type at(int row, int col) const { return cells[static_cast<size_t>(row) * cols + col]; }
+    void set(int row, int col, AlgaeType::Type type) { cells[static_cast<size_t>(row) * cols + col] = type; }
+    void resize(int newRows, int newCols); // 重设尺寸，所有格子清空
+
+    // 应用布局时的种植顺序（行优先下标，只含非空格）：蓝藻给周围加光，先种；其余后种。
+    // 两轮都自下而上、同行从左到右，下方格子种植时上方还没有新种的遮光
+    std::vector<int> plantingOrder() const;
+
+    // 取网格模型当前的种植情况与资源种子
+    static GridLayout fromGrid(const GridModel& grid);
+
+    // 读写布局文件，失败时返回false并在error中给出原因
+    bool load(const QString& path, QString* error = nullptr);
+    bool save(const QString& path, QString* error = nullptr) const;
+
+    // 类型与布局字符互转（'.'为NONE），无法识别的字符返回false
+    static char typeToChar(AlgaeType::Type type);
+    static bool charToType(char ch, AlgaeType::Type& type);
+};
+
+#endif // GRIDLAYOUT_H
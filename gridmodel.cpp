@@ -0,0 +1,827 @@
+#include "gridmodel.h" // 网格模型头文件
+#include <QRandomGenerator> // Qt随机数生成器
+#include <QtGlobal>         // qMin/qMax/qBound
+#include <algorithm>        // copy_n
+#include <cmath>            // exp
+#include <limits>           // 网格尺寸上限
+#include <thread>           // hardware_concurrency
+#include "nutrientkernel.h" // 氮碳批量计算内核
+#include "workerpool.h"     // 工作线程池
+
+GridModel::GridModel()
+    : m_rows(0)
+    , m_cols(0)
+    , m_stride(2)
+    , m_maxShadingDepth(AlgaeType::getMaxShadingDepth())
+    , m_produceTimer(0.0) // 产出计时器归零
+    , m_hasResourceSeed(false)
+    , m_resourceSeed(0)
+    , m_threadCount(qMax(1u, std::thread::hardware_concurrency()))
+{
+}
+
+GridModel::~GridModel() = default;
+
+void GridModel::setThreadCount(int threads)
+{
+    threads = qMax(1, threads);
+    if (m_threadCount != threads) {
+        m_threadCount = threads;
+        m_pool.reset(); // 下次需要时按新线程数重建
+    }
+}
+
+void GridModel::setResourceSeed(quint32 seed)
+{
+    m_hasResourceSeed = true;
+    m_resourceSeed = seed;
+}
+
+void GridModel::clearResourceSeed()
+{
+    m_hasResourceSeed = false;
+}
+
+double GridModel::LightProfile::lightAtDepth(int row) const
+{
+    const double light = curve == EXPONENTIAL ? surface * std::exp(-decay * row)
+                                              : surface - decay * row;
+    return qMax(minimum, light);
+}
+
+void GridModel::setLightProfile(const LightProfile& profile)
+{
+    m_lightProfile = profile;
+    if (m_rows == 0) {
+        return; // 尚未初始化，initialize时生效
+    }
+    rebuildBaseLight();
+    refreshAllLight();
+    // 产量与光照线性相关，所有已种植格子重算
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            const int i = index(row, col);
+            if (occupiedAt(i)) {
+                markProductionDirty(i);
+            }
+        }
+    }
+}
+
+void GridModel::rebuildBaseLight()
+{
+    m_baseLight.resize(m_rows);
+    for (int row = 0; row < m_rows; ++row) {
+        m_baseLight[row] = m_lightProfile.lightAtDepth(row);
+    }
+}
+
+void GridModel::initialize(int rows, int cols)
+{
+    allocateCells(rows, cols);
+    initializeResources(); // 初始化资源
+}
+
+// 按尺寸分配单元格字段（含边界），所有格子为空，产量合计清零
+void GridModel::allocateCells(int rows, int cols)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_stride = m_cols + 2; // 左右各一格边界
+    const size_t total = static_cast<size_t>(m_rows + 2) * m_stride; // 上下各一行边界
+
+    // 所有单元格（含边界）初始为空
+    m_species.assign(total, AlgaeType::NONE);
+    m_status.assign(total, CellState::NORMAL);
+    m_traits.assign(total, 0);
+    m_productionDirty.assign(total, 0);
+    m_dirtyCells.clear();
+    m_multiplier.assign(total, 1.0);
+    m_timeSinceLightLow.assign(total, 0.0);
+    m_carbProduction.assign(total, 0.0);
+    m_lipidProduction.assign(total, 0.0);
+    m_proProduction.assign(total, 0.0);
+    m_vitProduction.assign(total, 0.0);
+    m_consumeN.assign(total, 0.0);
+    m_consumeC.assign(total, 0.0);
+
+    m_productionTotals = FixedSums();
+    m_produceTimer = 0.0;
+}
+
+void GridModel::saveState(State& state) const
+{
+    const size_t cells = static_cast<size_t>(m_rows) * m_cols;
+    state.rows = m_rows;
+    state.cols = m_cols;
+    state.lightProfile = m_lightProfile;
+    state.hasResourceSeed = m_hasResourceSeed;
+    state.resourceSeed = m_resourceSeed;
+    state.produceTimer = m_produceTimer;
+    state.species.resize(cells);
+    state.status.resize(cells);
+    state.timeSinceLightLow.resize(cells);
+    state.nitrogen.resize(cells);
+    state.carbon.resize(cells);
+    state.nitrogenRegenBase.resize(cells);
+    state.carbonRegenBase.resize(cells);
+    // 逐行跳过左右边界格复制
+    for (int row = 0; row < m_rows; ++row) {
+        const int from = index(row, 0);
+        const size_t to = static_cast<size_t>(row) * m_cols;
+        std::copy_n(&m_species[from], m_cols, &state.species[to]);
+        std::copy_n(&m_status[from], m_cols, &state.status[to]);
+        std::copy_n(&m_timeSinceLightLow[from], m_cols, &state.timeSinceLightLow[to]);
+        std::copy_n(&m_nitrogen[from], m_cols, &state.nitrogen[to]);
+        std::copy_n(&m_carbon[from], m_cols, &state.carbon[to]);
+        std::copy_n(&m_nitrogenRegenBase[from], m_cols, &state.nitrogenRegenBase[to]);
+        std::copy_n(&m_carbonRegenBase[from], m_cols, &state.carbonRegenBase[to]);
+    }
+}
+
+bool GridModel::isValidSize(int rows, int cols)
+{
+    // 先扩展到64位再加边界，rows/cols接近INT_MAX时也不会溢出
+    return rows >= 1 && cols >= 1 && (qint64(rows) + 2) * (qint64(cols) + 2) <= std::numeric_limits<int>::max();
+}
+
+bool GridModel::isValidState(const State& state)
+{
+    if (!isValidSize(state.rows, state.cols)) {
+        return false;
+    }
+    const size_t cells = static_cast<size_t>(state.rows) * state.cols;
+    if (state.species.size() != cells || state.status.size() != cells || state.timeSinceLightLow.size() != cells ||
+        state.nitrogen.size() != cells || state.carbon.size() != cells ||
+        state.nitrogenRegenBase.size() != cells || state.carbonRegenBase.size() != cells) {
+        return false;
+    }
+    for (size_t k = 0; k < cells; ++k) {
+        if (state.species[k] >= AlgaeType::TYPE_COUNT || state.status[k] > CellState::DYING) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GridModel::restoreState(const State& state)
+{
+    if (!isValidState(state)) {
+        return false;
+    }
+
+    m_lightProfile = state.lightProfile;
+    m_hasResourceSeed = state.hasResourceSeed;
+    m_resourceSeed = state.resourceSeed;
+    allocateCells(state.rows, state.cols);
+    m_produceTimer = state.produceTimer;
+    rebuildBaseLight();
+    const size_t total = static_cast<size_t>(m_rows + 2) * m_stride;
+    m_nitrogen.assign(total, 0.0);
+    m_nitrogenRegen.assign(total, 0.0);
+    m_nitrogenRegenBase.assign(total, 0.0);
+    m_carbon.assign(total, 0.0);
+    m_carbonRegen.assign(total, 0.0);
+    m_carbonRegenBase.assign(total, 0.0);
+    for (int row = 0; row < m_rows; ++row) {
+        const size_t from = static_cast<size_t>(row) * m_cols;
+        const int to = index(row, 0);
+        std::copy_n(&state.species[from], m_cols, &m_species[to]);
+        std::copy_n(&state.status[from], m_cols, &m_status[to]);
+        std::copy_n(&state.timeSinceLightLow[from], m_cols, &m_timeSinceLightLow[to]);
+        std::copy_n(&state.nitrogen[from], m_cols, &m_nitrogen[to]);
+        std::copy_n(&state.carbon[from], m_cols, &m_carbon[to]);
+        std::copy_n(&state.nitrogenRegenBase[from], m_cols, &m_nitrogenRegenBase[to]);
+        std::copy_n(&state.carbonRegenBase[from], m_cols, &m_carbonRegenBase[to]);
+    }
+
+    // 类型全部就位后再推导：特性与恢复速率依赖邻居，产量依赖光照
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            const int i = index(row, col);
+            const AlgaeType::Properties& props = AlgaeType::getProperties(static_cast<AlgaeType::Type>(m_species[i]));
+            m_consumeN[i] = props.consumeRateN;
+            m_consumeC[i] = props.consumeRateC;
+            m_traits[i] = computeTraits(i);
+            refreshRegen(i);
+        }
+    }
+    refreshAllLight();
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            const int i = index(row, col);
+            if (occupiedAt(i)) {
+                markProductionDirty(i);
+            }
+        }
+    }
+    recomputeDirtyProduction();
+    return true;
+}
+
+CellState GridModel::getCell(int row, int col) const {
+    CellState cell;
+    if (!contains(row, col)) {
+        return cell;
+    }
+    const int i = index(row, col);
+    const quint8 traits = m_traits[i];
+    cell.type = static_cast<AlgaeType::Type>(m_species[i]);
+    cell.status = static_cast<CellState::Status>(m_status[i]);
+    cell.productionMultiplier = m_multiplier[i];
+    cell.timeSinceLightLow = m_timeSinceLightLow[i];
+    cell.carbProduction = m_carbProduction[i];
+    cell.lipidProduction = m_lipidProduction[i];
+    cell.proProduction = m_proProduction[i];
+    cell.vitProduction = m_vitProduction[i];
+    cell.reducedByNeighborA = traits & TRAIT_REDUCED_BY_A;
+    cell.boostedByNeighborB = traits & TRAIT_BOOSTED_BY_B;
+    cell.reducedByNeighborB = traits & TRAIT_REDUCED_BY_B;
+    cell.synergizedByNeighbor = traits & TRAIT_SYNERGIZED;
+    cell.synergizingNeighbor = traits & TRAIT_SYNERGIZING;
+    cell.lightedByE = traits & TRAIT_LIGHTED_BY_E;
+    return cell;
+}
+
+void GridModel::notifyCellChanged(int row, int col) {
+    if (m_cellChanged) {
+        m_cellChanged(row, col);
+    }
+}
+
+// 种植函数
+CellState::PlantResult GridModel::plant(int row, int col, AlgaeType::Type type, double lightLevel, bool canAfford, bool canReserve) {
+    if (!contains(row, col)) {
+        return CellState::PLANT_OCCUPIED;
+    }
+    const int i = index(row, col);
+    if (occupiedAt(i)) {
+        return CellState::PLANT_OCCUPIED;
+    }
+    const AlgaeType::Properties& props = AlgaeType::getProperties(type); // 获取属性
+    if (lightLevel < props.lightRequiredPlant) { // 光照不足
+        if (lightLevel >= props.lightRequiredMaintain) { // 允许缓慢生长
+            m_species[i] = type;
+            m_status[i] = CellState::LIGHT_LOW;
+            m_multiplier[i] = 0.5;
+            m_timeSinceLightLow[i] = 0.0;
+            refreshAround(row, col);
+            notifyCellChanged(row, col);
+            return CellState::PLANT_LIGHT_LOW;
+        } else { // 完全不能种植
+            notifyCellChanged(row, col);
+            return CellState::PLANT_LIGHT_INSUFFICIENT;
+        }
+    }
+    if (!canAfford) {
+        if (canReserve) {
+            m_species[i] = type;
+            m_status[i] = CellState::RESOURCE_LOW;
+            m_multiplier[i] = 0.0;
+            refreshAround(row, col);
+            notifyCellChanged(row, col);
+            return CellState::PLANT_RESERVED;
+        } else {
+            return CellState::PLANT_RESOURCE_LOW;
+        }
+    }
+    // 正常种植
+    m_species[i] = type;
+    m_status[i] = CellState::NORMAL;
+    m_multiplier[i] = 1.0;
+    m_timeSinceLightLow[i] = 0.0;
+    refreshAround(row, col);
+    notifyCellChanged(row, col);
+    return CellState::PLANT_SUCCESS;
+}
+
+bool GridModel::remove(int row, int col) {
+    if (!contains(row, col) || !occupiedAt(index(row, col))) {
+        return false;
+    }
+    const int i = index(row, col);
+    m_species[i] = AlgaeType::NONE;
+    m_status[i] = CellState::NORMAL;
+    m_multiplier[i] = 1.0;
+    m_timeSinceLightLow[i] = 0.0;
+    refreshAround(row, col);
+    applyRemoveBonus(row, col);
+    notifyCellChanged(row, col);
+    return true;
+}
+
+void GridModel::replace(int row, int col, AlgaeType::Type type) {
+    if (!contains(row, col)) {
+        return;
+    }
+    const int i = index(row, col);
+    if (m_species[i] == type) {
+        return;
+    }
+    m_species[i] = type;
+    m_status[i] = CellState::NORMAL;
+    m_multiplier[i] = 1.0;
+    m_timeSinceLightLow[i] = 0.0;
+    refreshAround(row, col);
+    notifyCellChanged(row, col);
+}
+
+// 按下标从头计算光照（i必须是网格内格子，边界格保证邻居访问不越界）
+double GridModel::computeLightAt(int i) const {
+    double base = m_baseLight[rowOf(i)] - calculateShadingAt(rowOf(i), colOf(i));
+    // 蓝藻叠加光照
+    int blueAlgaeLight = 0;
+    for (int dr = -1; dr <= 1; ++dr) {
+        const int rowStart = i + dr * m_stride;
+        for (int dc = -1; dc <= 1; ++dc) {
+            if (m_species[rowStart + dc] == AlgaeType::TYPE_E) {
+                blueAlgaeLight += 4;
+            }
+        }
+    }
+    base += blueAlgaeLight;
+    return base;
+}
+
+double GridModel::getLightAt(int row, int col) const {
+    if (contains(row, col)) {
+        return lightAt(index(row, col));
+    }
+    return 0.0;
+}
+
+// 单格类型变化后，刷新受影响格子的光照、特性与产量：
+// 周围3x3（特性邻域与E型加光范围）以及本列下方最大遮光深度内的格子，
+// 受影响的格子只标脏，产量在下一次update时统一重算；没有种植/移除时每帧不做任何特性计算
+void GridModel::refreshAround(int row, int col) {
+    const int center = index(row, col);
+    const AlgaeType::Properties& props = AlgaeType::getProperties(static_cast<AlgaeType::Type>(m_species[center]));
+    m_consumeN[center] = props.consumeRateN;
+    m_consumeC[center] = props.consumeRateC;
+
+    const int lastRow = qMin(m_rows - 1, row + qMax(1, m_maxShadingDepth));
+    for (int r = qMax(0, row - 1); r <= lastRow; ++r) {
+        const bool inFootprint = r <= row + 1;
+        const int firstCol = inFootprint ? qMax(0, col - 1) : col;
+        const int lastCol = inFootprint ? qMin(m_cols - 1, col + 1) : col;
+        for (int c = firstCol; c <= lastCol; ++c) {
+            const int i = index(r, c);
+            m_light[i] = computeLightAt(i);
+            if (inFootprint) {
+                m_traits[i] = computeTraits(i);
+                refreshRegen(i);
+                ++m_tickStats.traitRecomputes;
+            }
+            markProductionDirty(i);
+        }
+    }
+}
+
+// 整网格光照扫描：自上而下逐行推进，每列维护当前遮光累计值。
+// 第r行藻类的遮光作用于r+1..r+shadingDepth行，在r+shadingDepth+1行到期，
+// 到期量记在长度为(最大遮光深度+1)的环形缓冲里，每格只做常数次操作
+template <typename Store>
+void GridModel::sweepLightField(Store store) const {
+    const int ringRows = m_maxShadingDepth + 1;
+    std::vector<int> running(m_cols, 0);                                 // 每列当前遮光
+    std::vector<int> expiring(static_cast<size_t>(ringRows) * m_cols, 0); // 各行到期的遮光量
+
+    for (int row = 0; row < m_rows; ++row) {
+        int* expireNow = &expiring[static_cast<size_t>(row % ringRows) * m_cols];
+        const int rowStart = index(row, 0);
+        for (int col = 0; col < m_cols; ++col) {
+            running[col] -= expireNow[col];
+            expireNow[col] = 0;
+
+            // 蓝藻叠加光照
+            const int i = rowStart + col;
+            int blueAlgae = 0;
+            for (int dr = -1; dr <= 1; ++dr) {
+                const int n = i + dr * m_stride;
+                blueAlgae += (m_species[n - 1] == AlgaeType::TYPE_E)
+                           + (m_species[n] == AlgaeType::TYPE_E)
+                           + (m_species[n + 1] == AlgaeType::TYPE_E);
+            }
+            store(row, col, m_baseLight[row] - running[col] + blueAlgae * 4);
+
+            // 本格藻类对下方的遮光
+            if (occupiedAt(i)) {
+                const AlgaeType::Type type = static_cast<AlgaeType::Type>(m_species[i]);
+                const AlgaeType::Properties& props = AlgaeType::getProperties(type);
+                if (props.shadingDepth > 0) {
+                    const int amount = props.shadingAmount + (type == AlgaeType::TYPE_A ? 3 : 0); // A型藻类额外遮光
+                    running[col] += amount;
+                    expiring[static_cast<size_t>((row + props.shadingDepth + 1) % ringRows) * m_cols + col] += amount;
+                }
+            }
+        }
+    }
+}
+
+bool GridModel::computeLightField(float* out, size_t size) const {
+    if (size < static_cast<size_t>(m_rows) * m_cols) {
+        return false;
+    }
+    sweepLightField([this, out](int row, int col, double light) {
+        out[static_cast<size_t>(row) * m_cols + col] = static_cast<float>(light);
+    });
+    return true;
+}
+
+void GridModel::refreshAllLight() {
+    m_light.assign(static_cast<size_t>(m_rows + 2) * m_stride, 0.0);
+    sweepLightField([this](int row, int col, double light) {
+        m_light[index(row, col)] = light;
+    });
+}
+
+double GridModel::getLightAt(int row) const {
+    return getLightAt(row, 0);
+}
+
+double GridModel::getNitrogenAt(int row, int col) const {
+    if (contains(row, col)) {
+        return m_nitrogen[index(row, col)];
+    }
+    return 0.0;
+}
+
+double GridModel::getCarbonAt(int row, int col) const {
+    if (contains(row, col)) {
+        return m_carbon[index(row, col)];
+    }
+    return 0.0;
+}
+
+double GridModel::getNitrogenRegenRate(int row, int col) const {
+    if (contains(row, col)) {
+        return m_nitrogenRegen[index(row, col)];
+    }
+    return 0.0;
+}
+
+double GridModel::getCarbonRegenRate(int row, int col) const {
+    if (contains(row, col)) {
+        return m_carbonRegen[index(row, col)];
+    }
+    return 0.0;
+}
+
+// 网格整体更新，每帧调用
+void GridModel::update(double deltaTime) {
+    // 1. 重算被种植/移除影响的格子产量，每格每帧至多一次
+    recomputeDirtyProduction();
+
+    // 2. 按行块并行：消耗局部资源 → 累计产出 → 按光照刷新状态
+    m_produceTimer += deltaTime;
+    const bool produceNow = m_produceTimer >= 10.0; // 每10秒产出一次
+    const int tileCount = (m_rows + TILE_ROWS - 1) / TILE_ROWS;
+    m_tileSums.assign(tileCount, ProduceSums());
+    if (tileCount > 1 && m_threadCount > 1) {
+        if (!m_pool) {
+            m_pool.reset(new WorkerPool(m_threadCount));
+        }
+        m_pool->run(tileCount, [this, deltaTime, produceNow](int tile) {
+            updateTile(tile, deltaTime, produceNow);
+        });
+    } else {
+        for (int tile = 0; tile < tileCount; ++tile) {
+            updateTile(tile, deltaTime, produceNow);
+        }
+    }
+
+    // 3. 产出资源逻辑：按行块顺序合并部分和
+    if (produceNow) {
+        ProduceSums total;
+        for (const ProduceSums& sums : m_tileSums) {
+            total.carb += sums.carb;
+            total.lipid += sums.lipid;
+            total.pro += sums.pro;
+            total.vit += sums.vit;
+        }
+        if (m_produce) {
+            m_produce(total.carb, total.lipid, total.pro, total.vit); // 通知产出
+        }
+        m_produceTimer = 0.0; // 计时器归零
+    }
+
+    m_lastTickStats = m_tickStats;
+    m_tickStats = TickStats();
+}
+
+// 更新一个行块，只读写块内格子
+void GridModel::updateTile(int tile, double deltaTime, bool produceNow) {
+    const int firstRow = tile * TILE_ROWS;
+    const int lastRow = qMin(m_rows, firstRow + TILE_ROWS);
+    ProduceSums& sums = m_tileSums[tile];
+    for (int row = firstRow; row < lastRow; ++row) {
+        const int rowStart = index(row, 0);
+        // 先整行消耗局部资源（空格子消耗为0，状态记为正常）
+        NutrientKernel::consume(&m_nitrogen[rowStart], &m_carbon[rowStart], &m_status[rowStart],
+                                &m_consumeN[rowStart], &m_consumeC[rowStart], deltaTime, m_cols);
+        for (int i = rowStart; i < rowStart + m_cols; ++i) {
+            if (!occupiedAt(i)) {
+                continue;
+            }
+            // 产出按消耗后的状态累计
+            if (produceNow && (m_status[i] == CellState::NORMAL || m_status[i] == CellState::RESOURCE_LOW)) {
+                sums.carb += m_carbProduction[i] * 10.0; // 10秒产量
+                sums.lipid += m_lipidProduction[i] * 10.0;
+                sums.pro += m_proProduction[i] * 10.0;
+                sums.vit += m_vitProduction[i] * 10.0;
+            }
+            // 再按光照刷新状态
+            updateCellStatus(i, deltaTime);
+        }
+    }
+}
+
+void GridModel::markProductionDirty(int i) {
+    if (!m_productionDirty[i]) {
+        m_productionDirty[i] = 1;
+        m_dirtyCells.push_back(i);
+    }
+}
+
+void GridModel::recomputeDirtyProduction() {
+    for (int i : m_dirtyCells) {
+        updateProductionRates(i);
+        m_productionDirty[i] = 0;
+    }
+    m_dirtyCells.clear();
+}
+
+// 重置网格和资源
+void GridModel::reset() {
+    // Reset all cells
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            remove(row, col); // 移除所有藻类
+        }
+    }
+
+    // Reset resources
+    initializeResources(); // 重新初始化资源
+    recomputeDirtyProduction(); // 游戏重置后处于暂停，立即清零产量
+}
+
+// 计算某格的遮光总量
+int GridModel::calculateShadingAt(int row, int col) const {
+    int totalShading = 0;
+    // 只考虑本列上方最大遮光深度内的遮荫，沿列按步长向下走
+    const int firstRow = qMax(0, row - m_maxShadingDepth);
+    int i = index(firstRow, col);
+    for (int r = firstRow; r < row; ++r, i += m_stride) {
+        if (occupiedAt(i)) {
+            totalShading += shadingFrom(static_cast<AlgaeType::Type>(m_species[i]), row - r);
+        }
+    }
+    return totalShading;
+}
+
+// 一株藻类对其下方distanceRows行处的遮光，超出遮光深度为0
+int GridModel::shadingFrom(AlgaeType::Type type, int distanceRows) {
+    if (type == AlgaeType::NONE) {
+        return 0;
+    }
+    const AlgaeType::Properties& props = AlgaeType::getProperties(type);
+    if (distanceRows > props.shadingDepth) {
+        return 0;
+    }
+    int shading = props.shadingAmount;
+    if (type == AlgaeType::TYPE_A) {
+        shading += 3; // A型藻类额外遮光
+    }
+    return shading;
+}
+
+// 移除藻类时奖励资源
+void GridModel::applyRemoveBonus(int row, int col) {
+    if (!contains(row, col)) {
+        return;
+    }
+    // Center cell
+    const int center = index(row, col);
+    m_nitrogen[center] += 10;
+    m_carbon[center] += 15;
+
+    // Surrounding 8 cells（边界格上的奖励不会被读取）
+    for (int dr = -1; dr <= 1; ++dr) {
+        const int rowStart = center + dr * m_stride;
+        for (int dc = -1; dc <= 1; ++dc) {
+            const int i = rowStart + dc;
+            if (i != center) {
+                m_nitrogen[i] += 5;
+                m_carbon[i] += 10;
+            }
+        }
+    }
+}
+
+// 初始化资源，包括光照、氮、碳及其恢复速率
+void GridModel::initializeResources() {
+    // 基础光照按曲线逐行生成，任意行数都有定义
+    rebuildBaseLight();
+
+    // Initialize nitrogen and carbon with random values（边界格为0）
+    const size_t total = static_cast<size_t>(m_rows + 2) * m_stride;
+    m_nitrogen.assign(total, 0.0);
+    m_nitrogenRegen.assign(total, 0.0);
+    m_nitrogenRegenBase.assign(total, 0.0);
+    m_carbon.assign(total, 0.0);
+    m_carbonRegen.assign(total, 0.0);
+    m_carbonRegenBase.assign(total, 0.0);
+
+    // 设置了种子时每次都从同一种子开始，同一布局的资源分布完全相同
+    QRandomGenerator seeded(m_resourceSeed);
+    QRandomGenerator* rng = m_hasResourceSeed ? &seeded : QRandomGenerator::global();
+    for (int row = 0; row < m_rows; ++row) {
+        for (int col = 0; col < m_cols; ++col) {
+            const int i = index(row, col);
+            // Random initial values
+            m_nitrogen[i] = rng->bounded(10, 18); // 10-17
+            m_carbon[i] = rng->bounded(30, 46);   // 30-45
+
+            // Random regeneration rates
+            m_nitrogenRegenBase[i] = rng->bounded(40, 61) / 10.0; // 4-6/s
+            m_carbonRegenBase[i] = rng->bounded(150, 301) / 10.0; // 15-30/s
+            refreshRegen(i);
+        }
+    }
+
+    refreshAllLight(); // 基础光照变化，整张光照缓存重建
+}
+
+// 预判在此处种植指定藻类后的光照（计入新藻类自身的遮光）
+double GridModel::getLightAtIfPlanted(int row, int col, AlgaeType::Type type) const {
+    if (!contains(row, col)) {
+        return 0.0;
+    }
+    int simulatedShading = calculateShadingAt(row, col); // 现有遮光
+    if (type != AlgaeType::NONE) {
+        const AlgaeType::Properties& props = AlgaeType::getProperties(type);
+        for (int d = 1; d <= props.shadingDepth; ++d) {
+            int targetRow = row + d;
+            if (targetRow < m_rows) {
+                simulatedShading += props.shadingAmount; // 预加新藻类遮光
+            }
+        }
+    }
+    return m_baseLight[row] - simulatedShading; // 返回预判光照
+}
+
+// 左右有B型时恢复速率翻倍
+void GridModel::refreshRegen(int i) {
+    const double boost = (m_traits[i] & TRAIT_REGEN_BY_B) ? 2.0 : 1.0;
+    m_nitrogenRegen[i] = m_nitrogenRegenBase[i] * boost;
+    m_carbonRegen[i] = m_carbonRegenBase[i] * boost;
+}
+
+// 按周围格子的藻类类型计算单格特性（只依赖3x3邻域，边界格为空）
+quint8 GridModel::computeTraits(int i) const {
+    const quint8 type = m_species[i];
+    const bool occupied = type != AlgaeType::NONE;
+    const quint8 up = m_species[i - m_stride];
+    const quint8 down = m_species[i + m_stride];
+    const quint8 left = m_species[i - 1];
+    const quint8 right = m_species[i + 1];
+    auto anyNeighbor4 = [&](quint8 wanted) {
+        return up == wanted || down == wanted || left == wanted || right == wanted;
+    };
+
+    quint8 traits = 0;
+    // A型：同类相邻减产
+    if (type == AlgaeType::TYPE_A && anyNeighbor4(AlgaeType::TYPE_A)) {
+        traits |= TRAIT_REDUCED_BY_A;
+    }
+    // B型：左右格被加速，恢复速率翻倍
+    const bool besideB = left == AlgaeType::TYPE_B || right == AlgaeType::TYPE_B;
+    if (besideB) {
+        traits |= TRAIT_REGEN_BY_B;
+        if (occupied) {
+            traits |= TRAIT_BOOSTED_BY_B;
+        }
+    }
+    // C型：与B相邻减产
+    if (type == AlgaeType::TYPE_C && anyNeighbor4(AlgaeType::TYPE_B)) {
+        traits |= TRAIT_REDUCED_BY_B;
+    }
+    // D型协同：与非D型藻类相邻时，自己和邻居都高亮
+    if (type == AlgaeType::TYPE_D) {
+        for (quint8 neighbor : { up, down, left, right }) {
+            if (neighbor != AlgaeType::NONE && neighbor != AlgaeType::TYPE_D) {
+                traits |= TRAIT_SYNERGIZING | TRAIT_SYNERGIZED;
+                break;
+            }
+        }
+    } else if (occupied && anyNeighbor4(AlgaeType::TYPE_D)) {
+        traits |= TRAIT_SYNERGIZED;
+    }
+    // E型：自身及周围8格加光（仅用于可视化，光照加成在光照计算中处理）
+    for (int dr = -1; dr <= 1; ++dr) {
+        const int n = i + dr * m_stride;
+        if (m_species[n - 1] == AlgaeType::TYPE_E || m_species[n] == AlgaeType::TYPE_E || m_species[n + 1] == AlgaeType::TYPE_E) {
+            traits |= TRAIT_LIGHTED_BY_E;
+            break;
+        }
+    }
+    return traits;
+}
+
+// 刷新单格产量
+void GridModel::updateProductionRates(int i) {
+    ++m_tickStats.productionRecomputes;
+    addToProductionTotals(i, -1); // 先移出本格旧产量，写入新产量后再加回
+    if (!occupiedAt(i)) {
+        m_carbProduction[i] = 0.0;
+        m_lipidProduction[i] = 0.0;
+        m_proProduction[i] = 0.0;
+        m_vitProduction[i] = 0.0;
+        return;
+    }
+    const AlgaeType::Type type = static_cast<AlgaeType::Type>(m_species[i]);
+    const quint8 traits = m_traits[i];
+    const AlgaeType::Properties& props = AlgaeType::getProperties(type);
+    double light = lightAt(i);
+    // 产量倍率与光照线性关联
+    double ratio = (light - props.lightRequiredSurvive) / (props.lightRequiredPlant - props.lightRequiredSurvive);
+    ratio = qBound(0.0, ratio, 1.0);
+    m_multiplier[i] = ratio;
+
+    // 基础产量
+    double carb = props.produceRateCarb * ratio;
+    double lipid = props.produceRateLipid * ratio;
+    double pro = props.produceRatePro * ratio;
+    double vit = props.produceRateVit * ratio;
+
+    // A型相邻减产：所有产量减半
+    if (type == AlgaeType::TYPE_A && (traits & TRAIT_REDUCED_BY_A)) {
+        carb *= 0.5;
+        lipid *= 0.5;
+        pro *= 0.5;
+        vit *= 0.5;
+    }
+    // B型被加速：所有产量翻倍（无论自身类型，只要被加速）
+    if (traits & TRAIT_BOOSTED_BY_B) {
+        carb *= 2.0;
+        lipid *= 2.0;
+        pro *= 2.0;
+        vit *= 2.0;
+    }
+    // C型被B减产：糖产量减半
+    if (type == AlgaeType::TYPE_C && (traits & TRAIT_REDUCED_BY_B)) {
+        carb *= 0.5;
+    }
+    // D型协同：自身或被协同时产量提升20%
+    if ((type == AlgaeType::TYPE_D && (traits & TRAIT_SYNERGIZING)) || (traits & TRAIT_SYNERGIZED)) {
+        carb *= 1.2;
+        lipid *= 1.2;
+        pro *= 1.2;
+        vit *= 1.2;
+    }
+
+    m_carbProduction[i] = carb;
+    m_lipidProduction[i] = lipid;
+    m_proProduction[i] = pro;
+    m_vitProduction[i] = vit;
+    addToProductionTotals(i, 1);
+}
+
+void GridModel::addToProductionTotals(int i, int sign) {
+    m_productionTotals.carb += sign * qRound64(m_carbProduction[i] * PRODUCTION_SCALE);
+    m_productionTotals.lipid += sign * qRound64(m_lipidProduction[i] * PRODUCTION_SCALE);
+    m_productionTotals.pro += sign * qRound64(m_proProduction[i] * PRODUCTION_SCALE);
+    m_productionTotals.vit += sign * qRound64(m_vitProduction[i] * PRODUCTION_SCALE);
+}
+
+GridModel::ProduceSums GridModel::getProductionTotals() const {
+    ProduceSums totals;
+    totals.carb = m_productionTotals.carb / PRODUCTION_SCALE;
+    totals.lipid = m_productionTotals.lipid / PRODUCTION_SCALE;
+    totals.pro = m_productionTotals.pro / PRODUCTION_SCALE;
+    totals.vit = m_productionTotals.vit / PRODUCTION_SCALE;
+    return totals;
+}
+
+// 根据光照刷新单格状态
+void GridModel::updateCellStatus(int i, double deltaTime) {
+    if (!occupiedAt(i)) {
+        return;
+    }
+    double currentLight = lightAt(i);
+    const AlgaeType::Properties& props = AlgaeType::getProperties(static_cast<AlgaeType::Type>(m_species[i]));
+    CellState::Status newStatus = CellState::NORMAL;
+    if (currentLight < props.lightRequiredSurvive) {
+        newStatus = CellState::DYING;
+        m_timeSinceLightLow[i] += deltaTime; // 按模拟时间累计，与帧率无关
+    } else if (currentLight < props.lightRequiredMaintain) {
+        newStatus = CellState::LIGHT_LOW;
+        m_timeSinceLightLow[i] = 0.0;
+    } else if (currentLight < props.lightRequiredPlant) {
+        newStatus = CellState::RESOURCE_LOW;
+        m_timeSinceLightLow[i] = 0.0;
+    } else {
+        m_timeSinceLightLow[i] = 0.0;
+    }
+    m_status[i] = newStatus;
+}
@@ -0,0 +1,283 @@
+#ifndef GRIDMODEL_H // 防止头文件重复包含
+#define GRIDMODEL_H
+
+#include <QtGlobal>   // quint8
+#include <functional> // 回调
+#include <memory>
+#include <vector>
+#include "algaetype.h"  // 藻类类型定义
+#include "cellstate.h"  // 单元格纯数据状态
+
+class WorkerPool;
+
+// 无界面的网格模型：管理所有单元格、光照、氮碳资源及特性规则
+// 不依赖QWidget，可在无显示环境下批量运行，界面层（GameGrid）只读取其状态
+//
+// 存储布局：每个字段一个连续的行优先数组（结构体数组转为数组结构体），
+// 四周各留一圈空白边界格（类型为NONE），邻居访问无需越界判断。
+//
+// 每帧更新按固定TILE_ROWS行切成行块，在工作线程池上并行执行；每帧的各阶段
+// 只读写本格数据（邻居相关的光照和特性在种植/移除时已算好），行块之间不需要交换边界行。
+// 产出汇总先按行块求部分和，再按行块编号顺序相加，结果与线程数无关、逐位一致。
+class GridModel {
+public:
+    using CellCallback = std::function<void(int row, int col)>; // 单元格变化回调
+    using ProduceCallback = std::function<void(double carb, double lipid, double pro, double vit)>; // 产出回调
+
+    // 特性标记位，与CellState中的特性布尔值一一对应
+    enum TraitFlag : quint8 {
+        TRAIT_REDUCED_BY_A   = 1 << 0, // A型同类相邻减产
+        TRAIT_BOOSTED_BY_B   = 1 << 1, // 被B型加速
+        TRAIT_REDUCED_BY_B   = 1 << 2, // C型被B型减产
+        TRAIT_SYNERGIZED     = 1 << 3, // 被D型协同
+        TRAIT_SYNERGIZING    = 1 << 4, // D型正在协同别人
+        TRAIT_LIGHTED_BY_E   = 1 << 5, // 被E型加光
+        TRAIT_REGEN_BY_B     = 1 << 6  // 左右有B型，恢复速率翻倍（空格子也生效）
+    };
+
+    // 每帧计算量统计，用于确认冗余计算已消除
+    struct TickStats {
+        int productionRecomputes = 0; // 产量重算次数
+        int traitRecomputes = 0;      // 特性重算次数
+    };
+
+    // 基础光照随深度（行号）的衰减曲线，第row行（0为水面）的基础光照：
+    //   LINEAR：surface - decay * row
+    //   EXPONENTIAL：surface * exp(-decay * row)
+    // 结果不低于minimum；默认值即原10行网格的30,28,...,12
+    struct LightProfile {
+        enum Curve { LINEAR, EXPONENTIAL };
+        Curve curve = LINEAR;
+        double surface = 30.0; // 水面光照
+        double decay = 2.0;    // 每行衰减量（LINEAR）或衰减系数（EXPONENTIAL）
+        double minimum = 0.0;  // 光照下限
+
+        double lightAtDepth(int row) const;
+    };
+
+    // 四种资源的数量（产出部分和、每秒产量合计等）
+    struct ProduceSums {
+        double carb = 0.0;
+        double lipid = 0.0;
+        double pro = 0.0;
+        double vit = 0.0;
+    };
+
+    // 存档用的模型状态：只含无法从其他字段推导的数据，单格数组按行优先排列（不含边界格）。
+    // 特性、光照、实际恢复速率、每格消耗与产量都在restoreState时重新推导，
+    // 推导结果与存档前逐位一致（产量合计为定点整数，与计算顺序无关）
+    struct State {
+        int rows = 0;
+        int cols = 0;
+        LightProfile lightProfile;
+        bool hasResourceSeed = false;
+        quint32 resourceSeed = 0;
+        double produceTimer = 0.0;
+        std::vector<quint8> species;            // 藻类类型
+        std::vector<quint8> status;             // 状态
+        std::vector<double> timeSinceLightLow;  // 光照低计时
+        std::vector<double> nitrogen;
+        std::vector<double> carbon;
+        std::vector<double> nitrogenRegenBase;  // 氮基础恢复速率
+        std::vector<double> carbonRegenBase;    // 碳基础恢复速率
+    };
+
+    static constexpr double PRODUCTION_SCALE = 1e9; // 产量合计的定点精度
+
+    static const int TILE_ROWS = 32; // 并行行块大小（固定值，保证汇总顺序与线程数无关）
+
+    GridModel();
+    ~GridModel();
+
+    GridModel(const GridModel&) = delete;
+    GridModel& operator=(const GridModel&) = delete;
+
+    // 更新使用的线程数（含调用线程），默认取硬件线程数；只有一个行块时始终单线程
+    void setThreadCount(int threads);
+    int getThreadCount() const { return m_threadCount; }
+
+    void initialize(int rows, int cols); // 按尺寸初始化网格和资源（行列数需为正），O(rows*cols)
+
+    // 基础光照曲线：设置后立即重建每行基础光照与光照缓存，已种植格子的产量标脏
+    void setLightProfile(const LightProfile& profile);
+    const LightProfile& getLightProfile() const { return m_lightProfile; }
+    double getBaseLight(int row) const { return row >= 0 && row < m_rows ? m_baseLight[row] : 0.0; }
+
+    // 资源随机种子：设置后每次初始化/重置资源都从该种子生成（结果可复现），默认使用全局随机数
+    void setResourceSeed(quint32 seed);
+    void clearResourceSeed();
+    bool hasResourceSeed() const { return m_hasResourceSeed; }
+    quint32 getResourceSeed() const { return m_resourceSeed; }
+    void update(double deltaTime);       // 网格整体更新，每帧调用
+    void reset();                        // 重置网格和资源
+    void recomputeDirtyProduction();     // 重算所有被标脏的格子的产量（update内自动调用）
+
+    // 存档：saveState按行复制各字段，O(rows*cols)；restoreState按状态重建整个网格（不逐格通知），
+    // 尺寸无效或数组长度不符时返回false且不修改模型
+    void saveState(State& state) const;
+    bool restoreState(const State& state);
+    static bool isValidState(const State& state); // restoreState会接受的状态（尺寸、数组长度与取值范围），不修改模型
+    // 行列数是否可用：都为正，且含边界格的总格数不超过int（格子下标为int）；行列数可以来自不可信的输入
+    static bool isValidSize(int rows, int cols);
+
+    // 所有格子当前每秒产量之和，O(1)读取；种植/移除后需recomputeDirtyProduction（或下一次update）才计入。
+    // 合计以定点整数（PRODUCTION_SCALE分之一）维护，单格产量重算时加减差值：
+    // 整数加减没有舍入误差，结果只取决于当前各格产量，与操作历史和顺序无关
+    ProduceSums getProductionTotals() const;
+
+    // 上一次update期间（含其前的种植/移除）的计算量统计
+    const TickStats& lastTickStats() const { return m_lastTickStats; }
+
+    // Grid properties
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+    bool contains(int row, int col) const { return row >= 0 && row < m_rows && col >= 0 && col < m_cols; }
+
+    CellState getCell(int row, int col) const; // 单格状态快照，越界返回空格子
+    AlgaeType::Type getTypeAt(int row, int col) const { return contains(row, col) ? static_cast<AlgaeType::Type>(m_species[index(row, col)]) : AlgaeType::NONE; }
+    bool isOccupied(int row, int col) const { return getTypeAt(row, col) != AlgaeType::NONE; }
+    CellState::Status getStatusAt(int row, int col) const { return contains(row, col) ? static_cast<CellState::Status>(m_status[index(row, col)]) : CellState::NORMAL; }
+    quint8 getTraitsAt(int row, int col) const { return contains(row, col) ? m_traits[index(row, col)] : 0; } // 特性标记位（TraitFlag）
+
+    // 假设网格上的藻类由typeAt(row, col)给出（NONE为空）时(row, col)处的光照，规则与getLightAt相同：
+    // 本列上方的遮光加上周围3x3蓝藻的加光；只读基础光照，供布局评估推算种植那一刻的光照
+    template <typename TypeAt>
+    double getLightWith(int row, int col, TypeAt typeAt) const;
+
+    // 单元格操作
+    CellState::PlantResult plant(int row, int col, AlgaeType::Type type, double lightLevel, bool canAfford, bool canReserve);
+    bool remove(int row, int col);
+    // 直接把一格换成指定类型（NONE为清空）：状态正常，不判定光照与资源，不发放移除奖励，
+    // 邻域只刷新一次；供布局评估等批量试算使用
+    void replace(int row, int col, AlgaeType::Type type);
+
+    // Light and resources（光照为缓存值，O(1)查询）
+    double getLightAt(int row) const;
+    double getLightAt(int row, int col) const;
+    double getNitrogenAt(int row, int col) const;
+    double getCarbonAt(int row, int col) const;
+    double getNitrogenRegenRate(int row, int col) const;
+    double getCarbonRegenRate(int row, int col) const;
+
+    // 一次扫描算出整张网格的光照，按行优先写入out（需至少rows*cols个元素），O(rows*cols)
+    // 元素不足时返回false且不写入
+    bool computeLightField(float* out, size_t size) const;
+
+    // Calculate combined effects
+    int calculateShadingAt(int row, int col) const;
+    void applyRemoveBonus(int row, int col);
+
+    // 悬浮预判种植后光照
+    double getLightAtIfPlanted(int row, int col, AlgaeType::Type type) const;
+
+    // 通知回调（替代原QWidget信号）
+    void setCellChangedCallback(CellCallback callback) { m_cellChanged = std::move(callback); }
+    void setProduceCallback(ProduceCallback callback) { m_produce = std::move(callback); }
+
+private:
+    int m_rows;
+    int m_cols;
+    int m_stride; // 每行元素数（含左右边界格）
+
+    // 单元格字段，下标为index(row, col)
+    std::vector<quint8> m_species;          // 藻类类型（AlgaeType::Type）
+    std::vector<quint8> m_status;           // 状态（CellState::Status）
+    std::vector<quint8> m_traits;           // 特性标记位（TraitFlag）
+    std::vector<quint8> m_productionDirty;  // 产量待重算标记
+    std::vector<int> m_dirtyCells;          // 待重算格子的下标列表
+    std::vector<double> m_multiplier;       // 产量倍率
+    std::vector<double> m_timeSinceLightLow;// 光照低计时（秒）
+    std::vector<double> m_carbProduction;   // 糖产量
+    std::vector<double> m_lipidProduction;  // 脂产量
+    std::vector<double> m_proProduction;    // 蛋白产量
+    std::vector<double> m_vitProduction;    // 维生素产量
+
+    // 局部资源字段，下标同上；恢复速率为已计入B型加成的实际值，
+    // 与每格消耗速率一起在种植/移除时刷新，每帧由NutrientKernel成段计算
+    std::vector<double> m_nitrogen;
+    std::vector<double> m_nitrogenRegen;
+    std::vector<double> m_nitrogenRegenBase; // 氮基础恢复速率（随机生成）
+    std::vector<double> m_carbon;
+    std::vector<double> m_carbonRegen;
+    std::vector<double> m_carbonRegenBase;   // 碳基础恢复速率（随机生成）
+    std::vector<double> m_consumeN;          // 每秒消耗氮（空格子为0）
+    std::vector<double> m_consumeC;          // 每秒消耗碳（空格子为0）
+
+    LightProfile m_lightProfile;     // 基础光照曲线
+    std::vector<double> m_baseLight; // 每行基础光照（由m_lightProfile生成）
+    std::vector<double> m_light;     // 每格光照缓存，只在种植/移除时局部刷新
+    int m_maxShadingDepth;           // 最大遮光深度，决定种植/移除后需要刷新的列范围
+
+    double m_produceTimer; // 每10秒产出一次的计时器
+
+    bool m_hasResourceSeed;  // 是否使用固定的资源随机种子
+    quint32 m_resourceSeed;  // 资源随机种子
+
+    std::vector<ProduceSums> m_tileSums; // 每个行块的产出部分和
+
+    // 每秒产量合计（定点），随单格产量重算增量维护
+    struct FixedSums {
+        qint64 carb = 0;
+        qint64 lipid = 0;
+        qint64 pro = 0;
+        qint64 vit = 0;
+    };
+    FixedSums m_productionTotals;
+
+    int m_threadCount;                   // 线程数
+    std::unique_ptr<WorkerPool> m_pool;  // 工作线程池（需要时才创建）
+
+    TickStats m_tickStats;     // 本帧累计
+    TickStats m_lastTickStats; // 上一帧结果
+
+    CellCallback m_cellChanged;
+    ProduceCallback m_produce;
+
+    int index(int row, int col) const { return (row + 1) * m_stride + (col + 1); }
+    int rowOf(int i) const { return i / m_stride - 1; }
+    int colOf(int i) const { return i % m_stride - 1; }
+    bool occupiedAt(int i) const { return m_species[i] != AlgaeType::NONE; }
+
+    void allocateCells(int rows, int cols); // 分配单元格字段，所有格子为空
+    void initializeResources();
+    void rebuildBaseLight(); // 按光照曲线生成每行基础光照
+    static int shadingFrom(AlgaeType::Type type, int distanceRows); // 一株藻类对其下方distanceRows行的遮光
+    quint8 computeTraits(int i) const; // 按3x3邻域计算单格特性
+    void refreshRegen(int i); // 按特性位刷新实际恢复速率
+    double lightAt(int i) const { return m_light[i]; }
+    double computeLightAt(int i) const;        // 从头计算单格光照
+    void refreshAround(int row, int col);      // 单格类型变化后刷新受影响格子的光照、特性与产量
+    void refreshAllLight();                    // 刷新整张光照缓存
+    template <typename Store>
+    void sweepLightField(Store store) const;   // 整网格光照扫描，结果逐格交给store(row, col, light)
+    void updateCellStatus(int i, double deltaTime);
+    void updateTile(int tile, double deltaTime, bool produceNow); // 更新一个行块：消耗、产出部分和、状态
+    void markProductionDirty(int i);
+    void updateProductionRates(int i);
+    void addToProductionTotals(int i, int sign); // 把单格产量按sign加入/移出合计
+    void notifyCellChanged(int row, int col);
+};
+
+template <typename TypeAt>
+double GridModel::getLightWith(int row, int col, TypeAt typeAt) const {
+    if (!contains(row, col)) {
+        return 0.0;
+    }
+    int shading = 0;
+    for (int r = qMax(0, row - m_maxShadingDepth); r < row; ++r) {
+        shading += shadingFrom(typeAt(r, col), row - r);
+    }
+    double light = m_baseLight[row] - shading;
+    int blueAlgaeLight = 0;
+    for (int r = row - 1; r <= row + 1; ++r) {
+        for (int c = col - 1; c <= col + 1; ++c) {
+            if (contains(r, c) && typeAt(r, c) == AlgaeType::TYPE_E) {
+                blueAlgaeLight += 4;
+            }
+        }
+    }
+    light += blueAlgaeLight;
+    return light;
+}
+
+#endif // GRIDMODEL_H
@@ -0,0 +1,341 @@
+#include "hudpanel.h" // 信息面板头文件
+#include <QPainter>    // 绘图
+#include <QPaintEvent> // 绘制事件
+#include <QFontMetrics>
+#include <QtMath>      // qCeil
+
+namespace {
+
+const int MARGIN = 2;        // 面板边距
+const int SECTION_GAP = 10;  // 分组间距
+const int PADDING = 8;       // 分组内边距
+const int ROW_GAP = 4;       // 行间距
+
+// 与GameResources的胜利条件一致
+const double WIN_RESOURCES[4] = { 500.0, 300.0, 200.0, 100.0 };
+const double TARGET_RATES[4] = { 50.0, 30.0, 20.0, 10.0 };
+const char* const RESOURCE_NAMES[4] = { "糖类", "脂质", "蛋白质", "维生素" };
+
+const QColor COLOR_TEXT(0xff, 0xff, 0xff);
+const QColor COLOR_OK(0x2e, 0xcc, 0x40);       // 资源与条件达标
+const QColor COLOR_RATE_OK(0xb2, 0xff, 0x59);  // 速率达标
+const QColor COLOR_MISS(0xe6, 0x7e, 0x22);     // 未达标
+const QColor COLOR_SECTION(40, 40, 40, 204);   // 分组底色
+const QColor COLOR_SECTION_BORDER(0x44, 0x44, 0x44);
+const QColor COLOR_FIELD(30, 30, 30, 178);     // 数值底色
+const QColor COLOR_SCORE(0x19, 0x76, 0xd2);
+const QColor COLOR_SCORE_BG(0xe3, 0xf2, 0xfd);
+const QColor COLOR_HINT(0xff, 0x98, 0x00);
+const QColor COLOR_DETAIL(0x21, 0x96, 0xf3);
+const QColor COLOR_PROGRESS_TEXT(0x22, 0x22, 0x22);
+
+QColor progressColor(double progress)
+{
+    if (progress < 0.3) return QColor(0xff, 0x33, 0x33);
+    if (progress < 0.7) return QColor(0xff, 0xcc, 0x33);
+    return QColor(0x33, 0xcc, 0x33);
+}
+
+QString goalText(double value, double target)
+{
+    return QString("%1 / %2 %3").arg(QString::number(value, 'f', 1)).arg(target, 0, 'f', 0).arg(value >= target ? "✅" : "❌");
+}
+
+QStaticText makeStatic(const QString& text)
+{
+    QStaticText staticText(text);
+    staticText.setTextFormat(Qt::PlainText);
+    return staticText;
+}
+
+} // namespace
+
+HudPanel::HudPanel(QWidget* parent)
+    : QWidget(parent),
+      m_contentHeight(0),
+      m_repaintedFields(0)
+{
+    setupFonts();
+    m_fields.resize(FIELD_COUNT);
+    m_fields[FIELD_PROGRESS].background = COLOR_SCORE_BG;
+    m_fields[FIELD_PROGRESS].font = FONT_VALUE;
+    m_fields[FIELD_SCORE].background = COLOR_SCORE_BG;
+    m_fields[FIELD_SCORE].font = FONT_SCORE;
+    m_fields[FIELD_HINT].font = FONT_HINT;
+    m_fields[FIELD_RESOURCE_SCORE].font = FONT_DETAIL;
+    m_fields[FIELD_RATE_SCORE].font = FONT_DETAIL;
+    m_fields[FIELD_TOTAL_SCORE].font = FONT_DETAIL;
+    for (int k = 0; k < 4; ++k) {
+        m_fields[FIELD_RESOURCE + k].font = FONT_VALUE;
+        m_fields[FIELD_RESOURCE + k].background = COLOR_FIELD;
+        m_fields[FIELD_RATE + k].font = FONT_RATE;
+        m_fields[FIELD_RATE + k].background = COLOR_FIELD;
+    }
+    for (int k = 0; k < 8; ++k) {
+        m_fields[FIELD_COND + k].font = FONT_COND;
+        m_fields[FIELD_COND + k].background = COLOR_FIELD;
+    }
+    layoutItems();
+    setSnapshot(Snapshot());
+}
+
+void HudPanel::setupFonts()
+{
+    const QFont base = font();
+    auto make = [&base](int pixelSize, bool bold) {
+        QFont f(base);
+        f.setPixelSize(pixelSize);
+        f.setBold(bold);
+        return f;
+    };
+    m_fonts[FONT_TITLE] = make(15, true);
+    m_fonts[FONT_LABEL] = make(14, false);
+    m_fonts[FONT_VALUE] = make(16, true);
+    m_fonts[FONT_RATE] = make(15, true);
+    m_fonts[FONT_SCORE] = make(20, true);
+    m_fonts[FONT_HINT] = make(16, true);
+    m_fonts[FONT_DETAIL] = make(13, false);
+    m_fonts[FONT_COND] = make(14, true);
+    for (QFont& f : m_fonts) {
+        f.setStyleStrategy(QFont::PreferAntialias);
+    }
+}
+
+QSize HudPanel::sizeHint() const
+{
+    return QSize(280, m_contentHeight);
+}
+
+QSize HudPanel::minimumSizeHint() const
+{
+    return QSize(220, m_contentHeight);
+}
+
+void HudPanel::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    layoutItems();
+}
+
+// 自上而下排列各分组；只有分数公式的换行与宽度有关，其余高度只由字体决定
+void HudPanel::layoutItems()
+{
+    m_labels.clear();
+    m_sections.clear();
+    const int width = qMax(minimumSizeHint().width(), this->width()) - 2 * MARGIN;
+    const int left = MARGIN;
+    int y = MARGIN;
+
+    auto lineHeight = [this](FontRole role) { return QFontMetrics(m_fonts[role]).height(); };
+    auto addLabel = [this](const QString& text, FontRole role, const QColor& color, int x, int top, int height) {
+        Label label;
+        label.text = makeStatic(text);
+        label.text.prepare(QTransform(), m_fonts[role]);
+        label.font = role;
+        label.color = color;
+        const int textHeight = QFontMetrics(m_fonts[role]).height();
+        label.pos = QPoint(x, top + (height - textHeight) / 2);
+        m_labels.append(label);
+    };
+    // 分组：标题在框内左上角，返回内容区顶部
+    auto beginSection = [&](const QString& title) {
+        Section section;
+        section.rect = QRect(left, y, width, 0);
+        section.title = makeStatic(title);
+        section.title.prepare(QTransform(), m_fonts[FONT_TITLE]);
+        section.titlePos = QPoint(left + PADDING, y + PADDING / 2);
+        m_sections.append(section);
+        y += PADDING / 2 + lineHeight(FONT_TITLE) + ROW_GAP;
+    };
+    auto endSection = [&]() {
+        y += PADDING;
+        m_sections.last().rect.setBottom(y - 1);
+        y += SECTION_GAP;
+    };
+    const int innerLeft = left + PADDING;
+    const int innerWidth = width - 2 * PADDING;
+
+    // 通关进度
+    beginSection("通关进度");
+    m_fields[FIELD_PROGRESS].rect = QRect(innerLeft, y, innerWidth, 28);
+    y += 28;
+    endSection();
+
+    // 分数栏（不带分组框，与原来的三栏一致）
+    const int scoreHeight = lineHeight(FONT_SCORE) + 12;
+    m_fields[FIELD_SCORE].rect = QRect(left, y, width, scoreHeight);
+    y += scoreHeight + ROW_GAP;
+    const int hintHeight = lineHeight(FONT_HINT) + 8;
+    m_fields[FIELD_HINT].rect = QRect(left, y, width, hintHeight);
+    y += hintHeight + ROW_GAP;
+    const int detailHeight = lineHeight(FONT_DETAIL) + 2;
+    addLabel("当前分数组成：", FONT_DETAIL, COLOR_DETAIL, left + 4, y, detailHeight);
+    y += detailHeight;
+    const int scoreFields[3] = { FIELD_RESOURCE_SCORE, FIELD_RATE_SCORE, FIELD_TOTAL_SCORE };
+    for (int id : scoreFields) {
+        m_fields[id].rect = QRect(left, y, width, detailHeight);
+        y += detailHeight;
+    }
+    const char* const formulas[3] = {
+        "资源得分 = (糖/500 + 脂/300 + 蛋白/200 + 维生素/100) / 4 × 50",
+        "速率得分 = (糖速/50 + 脂速/30 + 蛋白速/20 + 维生素速/10) / 4 × 50",
+        "总分 = 资源得分 + 速率得分（满100分后只看速率得分）"
+    };
+    for (const char* formula : formulas) {
+        Label label;
+        label.text = makeStatic(formula);
+        label.text.setTextWidth(width - 8); // 窄面板上自动换行
+        label.text.prepare(QTransform(), m_fonts[FONT_DETAIL]);
+        label.font = FONT_DETAIL;
+        label.color = COLOR_DETAIL;
+        label.pos = QPoint(left + 4, y);
+        m_labels.append(label);
+        y += qCeil(label.text.size().height()) + 2;
+    }
+    y += SECTION_GAP;
+
+    // 资源与生产速率：左列名称，右列数值
+    auto nameWidth = [this](const QStringList& names) {
+        const QFontMetrics fm(m_fonts[FONT_LABEL]);
+        int w = 0;
+        for (const QString& name : names) {
+            w = qMax(w, fm.horizontalAdvance(name));
+        }
+        return w + ROW_GAP * 2;
+    };
+    QStringList resourceNames, rateNames;
+    for (const char* name : RESOURCE_NAMES) {
+        resourceNames << QString("%1:").arg(name);
+        rateNames << QString("%1/秒:").arg(name);
+    }
+    auto addGoalRows = [&](const QString& title, const QStringList& names, int firstField, FontRole role) {
+        beginSection(title);
+        const int labelWidth = nameWidth(names);
+        const int rowHeight = lineHeight(role) + 8;
+        for (int k = 0; k < 4; ++k) {
+            addLabel(names[k], FONT_LABEL, COLOR_TEXT, innerLeft, y, rowHeight);
+            m_fields[firstField + k].rect = QRect(innerLeft + labelWidth, y, innerWidth - labelWidth, rowHeight);
+            y += rowHeight + (k < 3 ? ROW_GAP : 0);
+        }
+        endSection();
+    };
+    addGoalRows("资源", resourceNames, FIELD_RESOURCE, FONT_VALUE);
+    addGoalRows("生产速率", rateNames, FIELD_RATE, FONT_RATE);
+
+    // 胜利条件
+    beginSection("胜利条件");
+    const int condHeight = lineHeight(FONT_COND) + 4;
+    for (int k = 0; k < 8; ++k) {
+        m_fields[FIELD_COND + k].rect = QRect(innerLeft, y, innerWidth, condHeight);
+        y += condHeight + (k < 7 ? ROW_GAP : 0);
+    }
+    endSection();
+
+    const int height = y - SECTION_GAP + MARGIN;
+    if (height != m_contentHeight) {
+        m_contentHeight = height;
+        updateGeometry();
+    }
+    update();
+}
+
+void HudPanel::setField(int id, const QString& text, const QColor& color, int value)
+{
+    Field& field = m_fields[id];
+    if (field.text == text && field.color == color && field.value == value) {
+        return;
+    }
+    field.text = text;
+    field.color = color;
+    field.value = value;
+    field.layout = makeStatic(text);
+    field.layout.prepare(QTransform(), m_fonts[field.font]);
+    ++m_repaintedFields;
+    update(field.rect);
+}
+
+void HudPanel::setSnapshot(const Snapshot& s)
+{
+    const int percent = static_cast<int>(s.progress * 100);
+    setField(FIELD_PROGRESS, QString("%1%").arg(percent), progressColor(s.progress), percent);
+
+    setField(FIELD_SCORE, QString("分数：%1   最高分：%2").arg(s.score).arg(s.highScore), COLOR_SCORE);
+    QString hint;
+    if (!s.fullWin) hint = "当前未完全达标，分数已减半！";
+    else if (s.score < 60) hint = "继续努力，优化藻类布局！";
+    else if (s.score < 80) hint = "良好，距离目标不远了！";
+    else if (s.score < 100) hint = "优秀，快达成极限生产！";
+    else hint = "极限挑战，追求更高分数！";
+    setField(FIELD_HINT, hint, COLOR_HINT);
+    setField(FIELD_RESOURCE_SCORE, QString("资源得分：%1").arg(QString::number(s.resourceScore, 'f', 1)), COLOR_DETAIL);
+    setField(FIELD_RATE_SCORE, QString("速率得分：%1").arg(QString::number(s.rateScore, 'f', 1)), COLOR_DETAIL);
+    setField(FIELD_TOTAL_SCORE, QString("总分：%1").arg(s.score), COLOR_DETAIL);
+
+    for (int k = 0; k < 4; ++k) {
+        const bool resourceOk = s.resources[k] >= WIN_RESOURCES[k];
+        const bool rateOk = s.rates[k] >= TARGET_RATES[k];
+        setField(FIELD_RESOURCE + k, goalText(s.resources[k], WIN_RESOURCES[k]), resourceOk ? COLOR_OK : COLOR_MISS);
+        setField(FIELD_RATE + k, goalText(s.rates[k], TARGET_RATES[k]), rateOk ? COLOR_RATE_OK : COLOR_MISS);
+        setField(FIELD_COND + k, QString("%1：%2 / %3 %4").arg(RESOURCE_NAMES[k]).arg(s.resources[k], 0, 'f', 1)
+                                     .arg(WIN_RESOURCES[k], 0, 'f', 1).arg(resourceOk ? "✅" : "❌"),
+                 resourceOk ? COLOR_OK : COLOR_MISS);
+        setField(FIELD_COND + 4 + k, QString("%1速率：%2 / %3 %4").arg(RESOURCE_NAMES[k]).arg(s.rates[k], 0, 'f', 1)
+                                         .arg(TARGET_RATES[k], 0, 'f', 1).arg(rateOk ? "✅" : "❌"),
+                 rateOk ? COLOR_OK : COLOR_MISS);
+    }
+}
+
+// 只画与重绘区域相交的分组、文字和数值
+void HudPanel::paintEvent(QPaintEvent* event)
+{
+    const QRect dirty = event->rect();
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (const Section& section : m_sections) {
+        if (!section.rect.intersects(dirty)) continue;
+        painter.setPen(QPen(COLOR_SECTION_BORDER, 2));
+        painter.setBrush(COLOR_SECTION);
+        painter.drawRoundedRect(QRectF(section.rect).adjusted(1, 1, -1, -1), 10, 10);
+        painter.setFont(m_fonts[FONT_TITLE]);
+        painter.setPen(COLOR_TEXT);
+        painter.drawStaticText(section.titlePos, section.title);
+    }
+
+    for (const Label& label : m_labels) {
+        const QRect labelRect(label.pos, label.text.size().toSize());
+        if (!labelRect.intersects(dirty)) continue;
+        painter.setFont(m_fonts[label.font]);
+        painter.setPen(label.color);
+        painter.drawStaticText(label.pos, label.text);
+    }
+
+    for (int id = 0; id < m_fields.size(); ++id) {
+        const Field& field = m_fields[id];
+        if (!field.rect.intersects(dirty)) continue;
+        painter.setPen(Qt::NoPen);
+        if (field.background.isValid()) {
+            painter.setBrush(field.background);
+            painter.drawRoundedRect(field.rect, 8, 8);
+        }
+        if (id == FIELD_PROGRESS) {
+            // 进度条：按百分比填充，文字居中
+            const int fill = field.rect.width() * qBound(0, field.value, 100) / 100;
+            if (fill > 0) {
+                painter.setBrush(field.color);
+                painter.drawRoundedRect(QRect(field.rect.topLeft(), QSize(fill, field.rect.height())), 8, 8);
+            }
+            painter.setFont(m_fonts[field.font]);
+            painter.setPen(COLOR_PROGRESS_TEXT);
+            const QSizeF textSize = field.layout.size();
+            painter.drawStaticText(QPointF(field.rect.center().x() - textSize.width() / 2,
+                                           field.rect.center().y() - textSize.height() / 2 + 1), field.layout);
+            continue;
+        }
+        painter.setFont(m_fonts[field.font]);
+        painter.setPen(field.color);
+        const QSizeF textSize = field.layout.size();
+        painter.drawStaticText(QPointF(field.rect.left() + 6, field.rect.top() + (field.rect.height() - textSize.height()) / 2),
+                               field.layout);
+    }
+}
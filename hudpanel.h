@@ -0,0 +1,100 @@
+#ifndef HUDPANEL_H // 防止头文件重复包含
+#define HUDPANEL_H
+
+#include <QWidget>     // Qt控件基类
+#include <QStaticText> // 缓存排版的静态文本
+#include <QColor>
+#include <QFont>
+#include <QVector>
+
+// 自绘的信息面板：通关进度、分数、资源、生产速率与胜利条件
+//
+// 取代原来约20个QLabel与QProgressBar：整块面板由一份数据快照绘制，
+// 标题、名称等固定文字在布局时排好版缓存为QStaticText；
+// 每个数值是一个独立区域，setSnapshot只对文本或颜色真正变化的区域调用update(rect)，
+// 不触发样式表重新解析，也不引起布局重排。
+class HudPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    // 面板显示所需的全部数据（四种资源的顺序均为糖、脂质、蛋白质、维生素）
+    struct Snapshot {
+        double resources[4] = { 0.0, 0.0, 0.0, 0.0 }; // 资源储量
+        double rates[4] = { 0.0, 0.0, 0.0, 0.0 };     // 每秒产量
+        double progress = 0.0;                        // 通关进度（0~1）
+        int score = 0;                                // 当前分数
+        int highScore = 0;                            // 最高分
+        double resourceScore = 0.0;                   // 资源得分
+        double rateScore = 0.0;                       // 速率得分
+        bool fullWin = false;                         // 是否完全达标
+    };
+
+    explicit HudPanel(QWidget* parent = nullptr);
+
+    void setSnapshot(const Snapshot& snapshot); // 更新数据，只重绘变化的区域
+    int getRepaintedFields() const { return m_repaintedFields; } // 累计标记重绘的数值区域数（统计用）
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    // 字体编号
+    enum FontRole { FONT_TITLE, FONT_LABEL, FONT_VALUE, FONT_RATE, FONT_SCORE, FONT_HINT, FONT_DETAIL, FONT_COND, FONT_COUNT };
+
+    // 数值区域编号
+    enum FieldId {
+        FIELD_PROGRESS,
+        FIELD_SCORE,
+        FIELD_HINT,
+        FIELD_RESOURCE_SCORE,
+        FIELD_RATE_SCORE,
+        FIELD_TOTAL_SCORE,
+        FIELD_RESOURCE,                // 4个：资源储量
+        FIELD_RATE = FIELD_RESOURCE + 4, // 4个：每秒产量
+        FIELD_COND = FIELD_RATE + 4,     // 8个：胜利条件
+        FIELD_COUNT = FIELD_COND + 8
+    };
+
+    // 一个可独立重绘的数值区域
+    struct Field {
+        QRect rect;          // 区域（布局时确定）
+        QString text;        // 当前文本
+        QStaticText layout;  // 文本排版缓存，文本变化时才重排
+        QColor color;        // 文字颜色（进度条为填充颜色）
+        QColor background;   // 底色，无效时不画
+        FontRole font = FONT_VALUE;
+        int value = 0;       // 进度条百分比
+    };
+
+    // 固定文字
+    struct Label {
+        QPoint pos;
+        QStaticText text;
+        FontRole font;
+        QColor color;
+    };
+
+    // 分组外框
+    struct Section {
+        QRect rect;
+        QStaticText title;
+        QPoint titlePos;
+    };
+
+    QFont m_fonts[FONT_COUNT];
+    QVector<Field> m_fields;
+    QVector<Label> m_labels;
+    QVector<Section> m_sections;
+    int m_contentHeight;   // 所有分组的总高度
+    int m_repaintedFields;
+
+    void setupFonts();
+    void layoutItems();    // 按当前宽度计算各区域位置，并重建固定文字
+    void setField(int id, const QString& text, const QColor& color, int value = 0);
+};
+
+#endif // HUDPANEL_H
@@ -0,0 +1,336 @@
+#include "layoutoptimizer.h" // 布局优化器头文件
+#include <QElapsedTimer>      // 计时
+#include <QRandomGenerator>   // 每条链独立的随机数
+#include <cmath>              // exp/pow
+#include <thread>             // hardware_concurrency
+#include "workerpool.h"       // 工作线程池
+
+namespace {
+
+using Sums = GridModel::ProduceSums;
+
+// 按布局种好一张评估用网格（单线程，固定资源种子）；
+// 评估时直接换格子（不判定光照），稳态产量只由最终布局的光照与特性决定
+void setupGrid(GridModel& grid, const GridLayout& layout, const GridModel::LightProfile& light)
+{
+    grid.setThreadCount(1);
+    grid.setResourceSeed(layout.seed);
+    grid.setLightProfile(light);
+    grid.initialize(layout.rows, layout.cols);
+    for (int row = 0; row < layout.rows; ++row) {
+        for (int col = 0; col < layout.cols; ++col) {
+            const AlgaeType::Type type = layout.at(row, col);
+            if (type != AlgaeType::NONE) {
+                grid.replace(row, col, type);
+            }
+        }
+    }
+    grid.recomputeDirtyProduction();
+}
+
+// 在一格种下type相对起始布局的消耗：保留原有藻类或留空不花费
+Sums plantCost(AlgaeType::Type type, AlgaeType::Type startType)
+{
+    Sums cost;
+    if (type != AlgaeType::NONE && type != startType) {
+        const AlgaeType::Properties& props = AlgaeType::getProperties(type);
+        cost.carb = props.plantCostCarb;
+        cost.lipid = props.plantCostLipid;
+        cost.pro = props.plantCostPro;
+        cost.vit = props.plantCostVit;
+    }
+    return cost;
+}
+
+bool withinBudget(const Sums& spent, const LayoutOptimizer::Budget& budget)
+{
+    return spent.carb <= budget.carb && spent.lipid <= budget.lipid &&
+           spent.pro <= budget.pro && spent.vit <= budget.vit;
+}
+
+// 把起始布局改成cells时，k处新种的藻类在种植那一刻能否达到种植光照（保留原有藻类或留空总是可以）。
+// 按GridLayout::plantingOrder，不同的格子先移除：种非蓝藻时在场的是保留的藻类和布局中的全部蓝藻
+// （先种的新非蓝藻都在下方或同行，不遮它也不加光）；种蓝藻时在场的是保留的藻类和顺序在它之前的新蓝藻
+bool plantable(const GridModel& grid, const GridLayout& start, const std::vector<AlgaeType::Type>& cells, int k)
+{
+    const AlgaeType::Type type = cells[k];
+    if (type == AlgaeType::NONE || type == start.cells[k]) {
+        return true;
+    }
+    const int row = k / start.cols;
+    const int col = k % start.cols;
+    const bool lighter = type == AlgaeType::TYPE_E;
+    auto present = [&](int r, int c) {
+        const int j = r * start.cols + c;
+        const AlgaeType::Type t = cells[j];
+        if (t == start.cells[j] || (t == AlgaeType::TYPE_E && (!lighter || r > row || (r == row && c < col)))) {
+            return t;
+        }
+        return AlgaeType::NONE;
+    };
+    return grid.getLightWith(row, col, present) >= AlgaeType::getProperties(type).lightRequiredPlant;
+}
+
+// (row, col)改变后，受它影响的格子（周围3x3与本列下方最大遮光深度内）是否都还能种下
+bool plantableAround(const GridModel& grid, const GridLayout& start, const std::vector<AlgaeType::Type>& cells,
+                     int row, int col)
+{
+    const int lastRow = qMin(start.rows - 1, row + qMax(1, AlgaeType::getMaxShadingDepth()));
+    for (int r = qMax(0, row - 1); r <= lastRow; ++r) {
+        for (int c = qMax(0, col - 1); c <= qMin(start.cols - 1, col + 1); ++c) {
+            if ((r <= row + 1 || c == col) && !plantable(grid, start, cells, r * start.cols + c)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int countPlanted(const std::vector<AlgaeType::Type>& cells)
+{
+    int planted = 0;
+    for (AlgaeType::Type type : cells) {
+        planted += type != AlgaeType::NONE;
+    }
+    return planted;
+}
+
+// 一条搜索链的结果
+struct ChainResult {
+    std::vector<AlgaeType::Type> cells; // 本链找到的最好布局
+    double score = 0.0;
+    qint64 iterations = 0;
+};
+
+// 单条模拟退火链：每步随机选一格换成另一种类型（含留空），超预算或应用时种不下的步直接跳过，
+// 其余按Metropolis准则接受，拒绝时把这一格改回去；clock从整次搜索开始计时，时间上限所有链共用
+ChainResult runChain(const GridLayout& start, const LayoutOptimizer::Settings& settings, quint32 seed,
+                     const QElapsedTimer& clock)
+{
+    GridModel grid;
+    setupGrid(grid, start, settings.light);
+
+    std::vector<AlgaeType::Type> cells = start.cells;
+    int planted = countPlanted(cells);
+    Sums spent;
+    double current = LayoutOptimizer::score(grid.getProductionTotals(), settings);
+
+    ChainResult best;
+    best.cells = cells;
+    best.score = current;
+
+    QRandomGenerator rng(seed);
+    const int cellCount = start.rows * start.cols;
+    const qint64 iterations = settings.iterations > 0 ? settings.iterations
+                                                      : qint64(cellCount) * LayoutOptimizer::AUTO_ITERATIONS_PER_CELL;
+    const double cooling = iterations > 1
+        ? std::pow(settings.endTemperature / settings.startTemperature, 1.0 / double(iterations - 1))
+        : 1.0;
+    double temperature = settings.startTemperature;
+
+    // 只有通过预算检查、真正评估过的步才计入迭代次数并降温；预算紧时大部分提议不可行，
+    // 它们几乎不花时间，但总提议数仍有上限，防止没有可行步时死循环
+    qint64 evaluated = 0;
+    const qint64 maxProposals = iterations * 16;
+    for (qint64 proposals = 0; evaluated < iterations && proposals < maxProposals; ++proposals) {
+        if (settings.timeLimitMs > 0 && (proposals & 1023) == 0 && clock.elapsed() >= settings.timeLimitMs) {
+            break;
+        }
+        const int k = rng.bounded(cellCount);
+        const AlgaeType::Type from = cells[k];
+        int pick = rng.bounded(AlgaeType::TYPE_COUNT - 1); // 除当前类型外的其余类型（含NONE）
+        if (pick >= from) {
+            ++pick;
+        }
+        const AlgaeType::Type to = static_cast<AlgaeType::Type>(pick);
+
+        // 预算与格子数检查，不可行的步不评估
+        const int plantedAfter = planted + (to != AlgaeType::NONE) - (from != AlgaeType::NONE);
+        if (settings.maxPlants > 0 && plantedAfter > settings.maxPlants && plantedAfter > planted) {
+            continue;
+        }
+        const Sums oldCost = plantCost(from, start.cells[k]);
+        const Sums newCost = plantCost(to, start.cells[k]);
+        Sums spentAfter = spent;
+        spentAfter.carb += newCost.carb - oldCost.carb;
+        spentAfter.lipid += newCost.lipid - oldCost.lipid;
+        spentAfter.pro += newCost.pro - oldCost.pro;
+        spentAfter.vit += newCost.vit - oldCost.vit;
+        if (!withinBudget(spentAfter, settings.budget)) {
+            continue;
+        }
+        const int row = k / start.cols;
+        const int col = k % start.cols;
+        cells[k] = to;
+        if (!plantableAround(grid, start, cells, row, col)) {
+            cells[k] = from;
+            continue;
+        }
+
+        ++evaluated;
+        grid.replace(row, col, to);
+        grid.recomputeDirtyProduction();
+        const double candidate = LayoutOptimizer::score(grid.getProductionTotals(), settings);
+        const double delta = candidate - current;
+        if (delta >= 0.0 || rng.generateDouble() < std::exp(delta / temperature)) {
+            planted = plantedAfter;
+            spent = spentAfter;
+            current = candidate;
+            if (current > best.score) {
+                best.cells = cells;
+                best.score = current;
+            }
+        } else {
+            cells[k] = from;
+            grid.replace(row, col, from);
+            grid.recomputeDirtyProduction();
+        }
+        temperature *= cooling;
+    }
+    best.iterations = evaluated;
+    return best;
+}
+
+// 去掉不贡献分数的新种格子（节省种植消耗），按行优先逐格尝试；去掉后别的格子种不下的保留
+void pruneIdleCells(GridLayout& layout, const GridLayout& start, const LayoutOptimizer::Settings& settings)
+{
+    GridModel grid;
+    setupGrid(grid, layout, settings.light);
+    double current = LayoutOptimizer::score(grid.getProductionTotals(), settings);
+    const double tolerance = 1e-9; // 增量合计的舍入误差
+    for (int row = 0; row < layout.rows; ++row) {
+        for (int col = 0; col < layout.cols; ++col) {
+            const AlgaeType::Type type = layout.at(row, col);
+            if (type == AlgaeType::NONE || type == start.at(row, col)) {
+                continue;
+            }
+            layout.set(row, col, AlgaeType::NONE);
+            if (!plantableAround(grid, start, layout.cells, row, col)) {
+                layout.set(row, col, type);
+                continue;
+            }
+            grid.replace(row, col, AlgaeType::NONE);
+            grid.recomputeDirtyProduction();
+            const double without = LayoutOptimizer::score(grid.getProductionTotals(), settings);
+            if (without >= current - tolerance) {
+                current = without;
+            } else {
+                layout.set(row, col, type);
+                grid.replace(row, col, type);
+                grid.recomputeDirtyProduction();
+            }
+        }
+    }
+}
+
+} // namespace
+
+double LayoutOptimizer::score(const GridModel::ProduceSums& rates, const Settings& settings)
+{
+    return rates.carb * settings.weightCarb + rates.lipid * settings.weightLipid +
+           rates.pro * settings.weightPro + rates.vit * settings.weightVit;
+}
+
+GridModel::ProduceSums LayoutOptimizer::evaluate(const GridLayout& layout, const GridModel::LightProfile& light)
+{
+    GridModel grid;
+    setupGrid(grid, layout, light);
+    return grid.getProductionTotals();
+}
+
+GridModel::ProduceSums LayoutOptimizer::evaluateApplied(const GridLayout& start, const GridLayout& layout,
+                                                       const GridModel::LightProfile& light,
+                                                       GridModel::ProduceSums* cost)
+{
+    GridModel grid;
+    setupGrid(grid, start, light);
+    for (size_t k = 0; k < layout.cells.size(); ++k) {
+        if (start.cells[k] != AlgaeType::NONE && start.cells[k] != layout.cells[k]) {
+            grid.replace(static_cast<int>(k) / layout.cols, static_cast<int>(k) % layout.cols, AlgaeType::NONE);
+        }
+    }
+    Sums spent;
+    for (int k : layout.plantingOrder()) {
+        const int row = k / layout.cols;
+        const int col = k % layout.cols;
+        const AlgaeType::Type type = layout.cells[k];
+        if (grid.getTypeAt(row, col) == type) {
+            continue;
+        }
+        if (grid.plant(row, col, type, grid.getLightAt(row, col), true, false) == CellState::PLANT_SUCCESS) {
+            const Sums paid = plantCost(type, AlgaeType::NONE);
+            spent.carb += paid.carb;
+            spent.lipid += paid.lipid;
+            spent.pro += paid.pro;
+            spent.vit += paid.vit;
+        }
+    }
+    grid.recomputeDirtyProduction();
+    if (cost) {
+        *cost = spent;
+    }
+    return grid.getProductionTotals();
+}
+
+LayoutOptimizer::Result LayoutOptimizer::optimize(const GridLayout& start, const Settings& settings)
+{
+    QElapsedTimer clock;
+    clock.start();
+
+    Result result;
+    result.layout = start;
+    result.rates = evaluate(start, settings.light);
+    result.score = score(result.rates, settings);
+    result.startScore = result.score;
+    result.planted = countPlanted(start.cells);
+    if (start.rows <= 0 || start.cols <= 0) {
+        return result;
+    }
+
+    // 各链的种子由总种子依次生成，结果与线程数无关
+    const int chains = qMax(1, settings.chains);
+    std::vector<quint32> seeds(chains);
+    QRandomGenerator seeder(settings.seed);
+    for (quint32& seed : seeds) {
+        seed = seeder.generate();
+    }
+
+    std::vector<ChainResult> results(chains);
+    const int threads = qMin(chains, settings.threads > 0 ? settings.threads
+                                                          : qMax(1, static_cast<int>(std::thread::hardware_concurrency())));
+    auto runOne = [&](int chain) {
+        results[chain] = runChain(start, settings, seeds[chain], clock);
+    };
+    if (threads > 1) {
+        WorkerPool pool(threads);
+        pool.run(chains, runOne);
+    } else {
+        for (int chain = 0; chain < chains; ++chain) {
+            runOne(chain);
+        }
+    }
+
+    // 取分数最高的链，同分取编号小的
+    int bestChain = 0;
+    for (int chain = 0; chain < chains; ++chain) {
+        result.iterations += results[chain].iterations;
+        if (results[chain].score > results[bestChain].score) {
+            bestChain = chain;
+        }
+    }
+    if (results[bestChain].score > result.startScore) {
+        result.layout.cells = results[bestChain].cells;
+        pruneIdleCells(result.layout, start, settings);
+    }
+
+    // 最终结果按应用时的种植规则重新评估一次，预览给出的产量与消耗就是应用后的结果
+    result.rates = evaluateApplied(start, result.layout, settings.light, &result.cost);
+    result.score = score(result.rates, settings);
+    result.planted = countPlanted(result.layout.cells);
+    result.changed = 0;
+    for (size_t k = 0; k < result.layout.cells.size(); ++k) {
+        result.changed += result.layout.cells[k] != start.cells[k];
+    }
+    result.elapsedMs = clock.nsecsElapsed() / 1e6;
+    return result;
+}
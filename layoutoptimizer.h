@@ -0,0 +1,78 @@
+#ifndef LAYOUTOPTIMIZER_H // 防止头文件重复包含
+#define LAYOUTOPTIMIZER_H
+
+#include <QtGlobal>      // quint32/qint64
+#include <limits>
+#include "gridlayout.h"  // 网格布局
+#include "gridmodel.h"   // 网格模型（评估器与光照曲线）
+
+// 布局优化器：在种植预算内搜索加权稳态产量最高的布局（只依赖QtCore）
+//
+// 稳态产量即各格每秒产量之和（与游戏的生产速率一致），由光照与特性规则决定。
+// 评估直接使用GridModel：每步只改一格，种植/移除只刷新受影响的邻域，
+// 再从GridModel的产量合计读出新分数，每步代价与网格大小无关。
+//
+// 搜索为模拟退火：多条独立的搜索链（不同随机种子）分到工作线程池上并行，
+// 取分数最高的一条，再去掉不贡献分数的格子以节省种植消耗。
+// 起始布局中已有的藻类视为已付费，保留它们不计消耗，改种或新种才计入预算。
+// 评估时直接换格子、不判定光照，所以搜索只接受按AlgaeGame::applyLayout的顺序（GridLayout::plantingOrder）
+// 种植时每株新种藻类都达到种植光照的布局，应用后的产量与评估一致、消耗全部照常扣除。
+class LayoutOptimizer {
+public:
+    static const int AUTO_ITERATIONS_PER_CELL = 250; // 自动迭代次数：10x8网格每条链2万步
+
+    // 种植预算（四种资源），默认不限
+    struct Budget {
+        double carb = std::numeric_limits<double>::infinity();
+        double lipid = std::numeric_limits<double>::infinity();
+        double pro = std::numeric_limits<double>::infinity();
+        double vit = std::numeric_limits<double>::infinity();
+    };
+
+    struct Settings {
+        GridModel::LightProfile light;   // 基础光照曲线
+        // 各资源每秒产量的权重，默认按胜利条件的速率目标归一（50/30/20/10）
+        double weightCarb = 1.0 / 50.0;
+        double weightLipid = 1.0 / 30.0;
+        double weightPro = 1.0 / 20.0;
+        double weightVit = 1.0 / 10.0;
+        Budget budget;                   // 种植预算
+        int maxPlants = 0;               // 最多种植的格子数（含已有藻类），0为不限
+        int chains = 8;                  // 搜索链数
+        int threads = 0;                 // 线程数（含调用线程），0为硬件线程数
+        int iterations = 0;              // 每条链评估的步数（超预算的提议不计），0为按格子数自动（每格AUTO_ITERATIONS_PER_CELL步）
+        double startTemperature = 0.5;   // 初始温度（分数单位）
+        double endTemperature = 0.002;   // 结束温度，按几何级数降温
+        quint32 seed = 1;                // 随机种子，相同设置的结果完全相同
+        qint64 timeLimitMs = 0;          // 整次搜索的时间上限（毫秒，所有链共用），0为不限；触发后结果与机器速度有关
+    };
+
+    struct Result {
+        GridLayout layout;               // 建议布局（尺寸与种子同起始布局）
+        GridModel::ProduceSums rates;    // 按种植规则应用建议布局后的每秒产量（evaluateApplied）
+        GridModel::ProduceSums cost;     // 应用时实际扣除的种植消耗
+        double score = 0.0;              // 加权产量
+        double startScore = 0.0;         // 起始布局的加权产量
+        int planted = 0;                 // 建议布局中的藻类格子数
+        int changed = 0;                 // 与起始布局不同的格子数
+        qint64 iterations = 0;           // 所有链实际评估的步数之和
+        double elapsedMs = 0.0;          // 耗时（毫秒）
+    };
+
+    // 从起始布局出发搜索，返回最好的布局；起始布局本身总是可行的（已有藻类不计消耗）
+    static Result optimize(const GridLayout& start, const Settings& settings);
+
+    // 评估一个布局的每秒产量（按设置中的光照曲线）
+    static GridModel::ProduceSums evaluate(const GridLayout& layout, const GridModel::LightProfile& light);
+
+    // 按AlgaeGame::applyLayout的做法把起始布局改成layout（先移除不同的格子，再按种植顺序和种植规则种下），
+    // 返回得到的每秒产量；cost非空时给出实际扣除的消耗（光照略低时种下但不扣费，光照不足时种不下）
+    static GridModel::ProduceSums evaluateApplied(const GridLayout& start, const GridLayout& layout,
+                                                  const GridModel::LightProfile& light,
+                                                  GridModel::ProduceSums* cost = nullptr);
+
+    // 加权分数
+    static double score(const GridModel::ProduceSums& rates, const Settings& settings);
+};
+
+#endif // LAYOUTOPTIMIZER_H
@@ -5,9 +5,9 @@
 #include <QKeyEvent>      // 键盘事件
 #include <QMessageBox>    // 消息框
 #include <QInputDialog>   // 输入对话框
+#include <QFileDialog>    // 文件对话框
 #include <QPainter>       // 绘图
 #include <QMouseEvent>    // 鼠标事件
-#include <QEnterEvent>    // 鼠标进入事件
 #include <QToolTip>       // 工具提示
 #include <QColor>         // 颜色
 #include <QFont>          // 字体
@@ -23,19 +23,29 @@
 #include <QtMultimedia/QMediaPlayer> // 多媒体播放器
 #include <QtMultimedia/QAudioOutput> // 音频输出
 #include <QDebug>         // 调试输出
-#include <QSoundEffect>   // 音效
+#include "SoundManager.h" // 音效引擎
 #include <QMap>           // 字典
 #include <QTemporaryFile> // 临时文件
 #include <QFile>          // 文件
 #include <QStandardPaths> // 标准路径
+#include <QRandomGenerator> // 随机数
+#include "layoutoptimizer.h" // 布局优化器
 #include <QDir>           // 目录
 #include <QUrl>           // URL
-#include <QTextDocument>  // 文本文档
 #include <QScrollArea>    // 滚动区域
 #include <QPushButton>    // 按钮
 #include <QDialog>
+#include <QActionGroup>   // 互斥动作组
+#include <QScreen>        // 显示器刷新率
+#include <QWindow>        // 窗口所在显示器变化
+#include <limits>
+
+// 音效资源（QSoundEffect只支持WAV，种植音效改用planted.wav）
+static const QString EFFECT_PATH = "qrc:/resources/st30f0n665joahrrvuj05fechvwkcv10/";
+static const QString SOUND_PLANTED = EFFECT_PATH + "planted.wav";
+static const QString SOUND_DISPLANT = "qrc:/resources/displant.wav";
+static const QString SOUND_BUZZER = "qrc:/resources/buzzer.wav";
 
-// =================== CellWidget实现部分 ===================
 // 游戏胜利时的处理函数
 void MainWindow::onGameWon() {
     if (m_hasShownWinMsg) { // 已弹出胜利提示则不再弹出
@@ -66,7 +76,7 @@ void MainWindow::onGameWon() {
         totalScore /= 2; // 未完全达标分数减半
     }
     if (totalScore > m_highScore) m_highScore = totalScore; // 更新最高分
-    updateScoreBar(); // 刷新分数栏
+    updateHud(); // 刷新分数栏
     // 优化弹窗内容
     QString msg = tr("恭喜你通关！你已建立高效可持续的藻类生态系统！\n\n");
     msg += tr("【当前资源】\n");
@@ -92,7 +102,7 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
     if (event->key() == Qt::Key_Shift || event->key() == Qt::Key_Space) {
         if (!m_showShadingPreview) {
             m_showShadingPreview = true;
-            updateGridDisplay(); // 显示遮荫预览
+            m_gridView->setShadingPreview(true); // 显示悬停格子周围的遮荫预览
         }
     }
     QMainWindow::keyPressEvent(event); // 继续父类处理
@@ -103,7 +113,7 @@ void MainWindow::keyReleaseEvent(QKeyEvent *event) {
     if (event->key() == Qt::Key_Shift || event->key() == Qt::Key_Space) {
         if (m_showShadingPreview) {
             m_showShadingPreview = false;
-            updateGridDisplay(); // 关闭遮荫预览
+            m_gridView->setShadingPreview(false); // 关闭遮荫预览
         }
     }
     QMainWindow::keyReleaseEvent(event);
@@ -127,6 +137,7 @@ void MainWindow::showGameMenu() {
 
     QAction* restartAction = popupMenu.addAction(tr("重新开始"));
     QAction* settingsAction = popupMenu.addAction(tr("设置"));
+    QAction* suggestAction = popupMenu.addAction(tr("布局建议"));
     popupMenu.addSeparator();
     QAction* exitAction = popupMenu.addAction(tr("退出"));
 
@@ -143,6 +154,12 @@ void MainWindow::showGameMenu() {
             m_game->startGame(); // 设置后继续
             if (m_bgmPlayer) m_bgmPlayer->play(); // 恢复背景音乐
         }
+    } else if (selectedAction == suggestAction) {
+        suggestLayout();
+        if (wasRunning) {
+            m_game->startGame(); // 建议后继续
+            if (m_bgmPlayer) m_bgmPlayer->play(); // 恢复背景音乐
+        }
     } else if (selectedAction == exitAction) {
         exitGame();
     } else if (wasRunning) {
@@ -169,9 +186,7 @@ void MainWindow::restartGame() {
     m_hasShownWinMsg = false; // 允许新一轮通关弹窗
 
     // 刷新UI
-    updateGridDisplay();
-    onResourcesChanged();
-    onProductionRatesChanged();
+    m_uiScheduler->markDirty(UiScheduler::PANEL_ALL);
 
     statusBar()->showMessage(tr("游戏已重新开始"), 2000);
     if (m_bgmPlayer) m_bgmPlayer->play();
@@ -242,7 +257,7 @@ void MainWindow::showSettingsDialog() {
     connect(sfxSlider, &QSlider::valueChanged, [sfxValueLabel, this](int value) {
         sfxValueLabel->setText(QString::number(value));
         m_effectVolume = value / 100.0;
-        m_effectAudio->setVolume(m_effectVolume);
+        SoundManager::instance()->setVolume(m_effectVolume);
     });
 
     sfxLayout->addWidget(sfxLabel);
@@ -275,341 +290,64 @@ void MainWindow::showSettingsDialog() {
     }
 }
 
-CellWidget::CellWidget(int row, int col, QWidget* parent)
-    : QWidget(parent)
-    , m_row(row)
-    , m_col(col)
-    , m_cell(nullptr)
-{
-    setMinimumSize(50, 50);
-    setMaximumSize(80, 80);
-    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    setMouseTracking(true);
-    setFocusPolicy(Qt::StrongFocus);
-}
-
-void CellWidget::setAlgaeCell(AlgaeCell* cell) {
-    m_cell = cell;
-    update();
-}
-
-void CellWidget::paintEvent(QPaintEvent* event) {
-    Q_UNUSED(event);
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    int cellSize = qMin(width(), height()) - 4;
-    QRect cellRect(width()/2 - cellSize/2, height()/2 - cellSize/2, cellSize, cellSize);
-    // 蓝色渐变背景
-    QColor bgTop(40, 80, 180);
-    QColor bgBottom(10, 20, 60);
-    QLinearGradient grad(rect().topLeft(), rect().bottomLeft());
-    grad.setColorAt(0.0, bgTop);
-    grad.setColorAt(1.0, bgBottom);
-    painter.fillRect(rect(), grad);
-    // 2. 光照渐变带（底部）
-    if (m_cell) {
-        GameGrid* grid = nullptr;
-        if (m_cell->parentWidget()) {
-            grid = qobject_cast<GameGrid*>(m_cell->parentWidget());
-        }
-        double light = 0.0;
-        if (grid) light = grid->getLightAt(m_row, m_col); // 只用格子实际光照
-        int lightBarH = 4;
-        int lightBarW = width() - 8;
-        QRect lightRect(4, height() - lightBarH - 2, lightBarW, lightBarH);
-        int lightVal = qBound(0, static_cast<int>(light), 100);
-        QLinearGradient lightGrad(lightRect.topLeft(), lightRect.topRight());
-        lightGrad.setColorAt(0.0, QColor(120, 180, 255, 40));
-        lightGrad.setColorAt(1.0, QColor(120, 180, 255, 80 + lightVal));
-        painter.setBrush(lightGrad);
-        painter.setPen(Qt::NoPen);
-        painter.drawRect(lightRect);
-        // 图标+文字
-        QPixmap iconL(":/icons/light.png");
-        if (!iconL.isNull()) painter.drawPixmap(lightRect.left(), lightRect.top()-2, 14, 14, iconL);
-        painter.setPen(Qt::white);
-        painter.setFont(QFont("Arial", 7));
-        painter.drawText(lightRect.adjusted(16,0,0,0), Qt::AlignLeft|Qt::AlignVCenter, QString("光:%1").arg(lightVal));
-    }
-    // 3. 遮光区可视化（半透明蓝灰，强度递减）
-    if (m_cell && m_cell->isShadingVisible()) {
-        int depth = 1 + (m_row % 3);
-        int alpha = 40 + 30 * (depth-1);
-        QColor shadeColor = QColor(60, 80, 120, alpha);
-        painter.fillRect(cellRect, shadeColor);
-    }
-    // 4. 藻类图标更亮
-    if (m_cell && m_cell->getType() != AlgaeType::NONE) {
-        AlgaeType::Properties props = AlgaeType::getProperties(m_cell->getType());
-        QPixmap pix(props.imagePath);
-        if (!pix.isNull()) {
-            QPixmap shadow = pix.scaled(cellRect.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            QImage img = shadow.toImage();
-            QPainterPath path;
-            path.addRect(cellRect);
-            painter.save();
-            painter.setRenderHint(QPainter::Antialiasing, true);
-            painter.setOpacity(0.4);
-            painter.drawPixmap(cellRect.adjusted(2,2,2,2), shadow);
-            painter.setOpacity(1.0);
-            QPixmap brightPix = pix.scaled(cellRect.size(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            QImage brightImg = brightPix.toImage();
-            for(int y=0; y<brightImg.height(); ++y) for(int x=0; x<brightImg.width(); ++x) {
-                QColor c = brightImg.pixelColor(x,y);
-                c = c.lighter(130);
-                brightImg.setPixelColor(x,y,c);
-            }
-            painter.drawPixmap(cellRect, QPixmap::fromImage(brightImg));
-            QPen glowPen(QColor(220,240,255,220), 4);
-            painter.setPen(glowPen);
-            painter.drawRect(cellRect.adjusted(3,3,-3,-3));
-            painter.restore();
-        }
-    }
-    // 顶部中央：藻类状态（仅种植后显示）
-    if (m_cell && m_cell->isOccupied()) {
-        QString statusText;
-        QColor statusColor;
-        switch (m_cell->getStatus()) {
-            case AlgaeCell::NORMAL: statusText = "正常"; statusColor = QColor(0,255,0); break;
-            case AlgaeCell::RESOURCE_LOW: statusText = "资源低"; statusColor = QColor(255,165,0); break;
-            case AlgaeCell::LIGHT_LOW: statusText = "光照低"; statusColor = QColor(255,0,0); break;
-            case AlgaeCell::DYING: statusText = "濒死"; statusColor = QColor(255,0,128); break;
-        }
-        QFont font = painter.font();
-        font.setPointSize(11);
-        font.setBold(true);
-        painter.setFont(font);
-        painter.setPen(QPen(statusColor, 2));
-        QRect topRect(cellRect.left(), cellRect.top(), cellRect.width(), 22);
-        // 状态图标+文字
-        QPixmap iconS(":/icons/status.png");
-        if (!iconS.isNull()) painter.drawPixmap(topRect.left(), topRect.top()+2, 16, 16, iconS);
-        painter.drawText(topRect.adjusted(18,0,0,0), Qt::AlignLeft|Qt::AlignVCenter, statusText);
-    }
-    // 中央：未种植资源/可否种植标签（更显著）
-    if (m_cell && !m_cell->isOccupied()) {
-        GameGrid* grid = nullptr;
-        if (m_cell->parentWidget()) {
-            grid = qobject_cast<GameGrid*>(m_cell->parentWidget());
-        }
-        if (grid) {
-            double n = grid->getNitrogenAt(m_row, m_col);
-            double c = grid->getCarbonAt(m_row, m_col);
-            double l = 0.0;
-            AlgaeType::Type selType = AlgaeType::NONE;
-            MainWindow* mw = nullptr;
-            QWidget* w = grid->parentWidget();
-            while (w && !mw) { mw = qobject_cast<MainWindow*>(w); w = w->parentWidget(); }
-            if (mw) selType = mw->getGame()->getSelectedAlgaeType();
-            if (selType != AlgaeType::NONE && m_hovered) {
-                l = grid->getLightAtIfPlanted(m_row, m_col, selType);
-            } else {
-                l = grid->getLightAt(m_row, m_col); // 只用格子实际光照
-            }
-            // 图标+文字
-            QPixmap iconN(":/icons/nitrogen.png");
-            QPixmap iconC(":/icons/carbon.png");
-            QPixmap iconL(":/icons/light.png");
-            int iconY = cellRect.top()+cellRect.height()/2-18;
-            int iconX = cellRect.left()+12;
-            painter.drawPixmap(iconX, iconY, 14, 14, iconN);
-            painter.drawText(iconX+16, iconY+12, QString::number((int)n));
-            painter.drawPixmap(iconX+40, iconY, 14, 14, iconC);
-            painter.drawText(iconX+56, iconY+12, QString::number((int)c));
-            painter.drawPixmap(iconX+80, iconY, 14, 14, iconL);
-            painter.drawText(iconX+96, iconY+12, QString::number((int)l));
-            // 状态标签
-            QString statusTag;
-            QColor statusColor = Qt::white;
-            if (selType != AlgaeType::NONE) {
-                AlgaeType::Properties props = AlgaeType::getProperties(selType);
-                bool lightOK = l >= props.lightRequiredPlant;
-                bool resOK = AlgaeType::canAfford(selType, mw->getGame()->getResources()->getCarbohydrates(), mw->getGame()->getResources()->getLipids(), mw->getGame()->getResources()->getProteins(), mw->getGame()->getResources()->getVitamins());
-                if (!lightOK) { statusTag = "光照不足"; statusColor = QColor(255,0,0); }
-                else if (!resOK) { statusTag = "资源不足"; statusColor = QColor(255,165,0); }
-                else { statusTag = "可种植"; statusColor = QColor(0,255,0); }
-            }
-            QRect tagRect(cellRect.left()+8, cellRect.top()+cellRect.height()/2+8, cellRect.width()-16, 28);
-            if (!statusTag.isEmpty()) {
-                QFont font2("Arial", 14, QFont::Bold);
-                painter.setFont(font2);
-                painter.setPen(statusColor);
-                QColor bg = statusColor; bg.setAlpha(120);
-                painter.setBrush(bg);
-                painter.setPen(Qt::NoPen);
-                painter.drawRoundedRect(tagRect, 8, 8);
-                painter.setPen(statusColor.darker(180));
-                painter.drawText(tagRect, Qt::AlignCenter, statusTag);
-            }
-        }
-    }
-    if (m_hovered) {
-        QColor hoverColor = QColor(255, 255, 0, 180);
-        painter.setPen(QPen(hoverColor, 6, Qt::SolidLine));
-        painter.drawRect(cellRect.adjusted(2, 2, -2, -2));
-        QColor fillColor = QColor(255, 255, 180, 100);
-        painter.fillRect(cellRect.adjusted(6, 6, -6, -6), fillColor);
-    }
-    painter.setPen(QPen(Qt::darkBlue, 1));
-    painter.drawRect(rect().adjusted(0, 0, -1, -1));
-    painter.setPen(Qt::darkGray);
-    QFont smallFont = painter.font();
-    smallFont.setPointSize(6);
-    painter.setFont(smallFont);
-    painter.drawText(rect().adjusted(2, 2, -2, -2), Qt::AlignTop | Qt::AlignLeft,
-                     QString::number(m_row) + "," + QString::number(m_col));
-
-    // 5. 格外下方的高亮资源标注
-    GameGrid* grid = nullptr;
-    if (m_cell && m_cell->parentWidget()) {
-        grid = qobject_cast<GameGrid*>(m_cell->parentWidget());
-    }
-    if (grid) {
-        double n = grid->getNitrogenAt(m_row, m_col);
-        double c = grid->getCarbonAt(m_row, m_col);
-        double l = grid->getLightAt(m_row, m_col); // 只用格子实际光照
-
-        // 第一行：N、C，第二行：L
-        QRect outRect1(rect().left(), rect().bottom() - 44, rect().width(), 12); // N、C行更上移
-        QRect outRect2(rect().left(), rect().bottom() - 28, rect().width(), 16); // L行更上移
-
-        // N、C行，8号加粗
-        QFont fontNC("Arial", 8, QFont::Bold);
-        painter.setFont(fontNC);
-        QString ncText = QString("<span style='color:#fff;'>N:%1 C:%2</span>")
-                            .arg((int)n).arg((int)c);
-        QTextDocument docNC;
-        docNC.setHtml(QString("<div align='center' style='line-height:11px;margin:0;padding:0;'>%1</div>").arg(ncText));
-        painter.save();
-        painter.translate(outRect1.left(), outRect1.top());
-        docNC.setTextWidth(outRect1.width());
-        docNC.drawContents(&painter, QRectF(0, 0, outRect1.width(), outRect1.height()));
-        painter.restore();
-
-        // L行，10号加粗
-        QFont fontL("Arial", 10, QFont::Bold);
-        painter.setFont(fontL);
-        QString lText = QString("<span style='color:#fff;'>L:%1</span>").arg((int)l);
-        QTextDocument docL;
-        docL.setHtml(QString("<div align='center' style='line-height:14px;margin:0;padding:0;'>%1</div>").arg(lText));
-        painter.save();
-        painter.translate(outRect2.left(), outRect2.top());
-        docL.setTextWidth(outRect2.width());
-        docL.drawContents(&painter, QRectF(0, 0, outRect2.width(), outRect2.height()));
-        painter.restore();
+// 布局建议：以当前资源为种植预算，搜索加权产量最高的布局（已种的藻类不计消耗），确认后按游戏规则种下
+void MainWindow::suggestLayout() {
+    // 暂停游戏
+    bool wasRunning = m_game->isGameRunning();
+    if (wasRunning) {
+        m_game->pauseGame();
     }
 
-    // --- 藻类特性可视化 ---
-    if (m_cell) {
-        // A型相邻减产：左上角红色圆底白色粗体"-"
-        if (m_cell->getType() == AlgaeType::TYPE_A && m_cell->isReducedByNeighborA()) {
-            painter.save();
-            int r = 18;
-            QRect markRect(cellRect.left()+2, cellRect.top()+2, r, r);
-            painter.setBrush(QColor(220,0,0));
-            painter.setPen(Qt::NoPen);
-            painter.drawEllipse(markRect);
-            QFont f = painter.font(); f.setPointSize(14); f.setBold(true); painter.setFont(f);
-            painter.setPen(Qt::white);
-            painter.drawText(markRect, Qt::AlignCenter, "-");
-            painter.restore();
-        }
-        // B型被加速：右上角绿色圆底白色粗体"+"
-        if (m_cell->isBoostedByNeighborB()) {
-            painter.save();
-            int r = 18;
-            QRect markRect(cellRect.right()-r-2, cellRect.top()+2, r, r);
-            painter.setBrush(QColor(0,180,0));
-            painter.setPen(Qt::NoPen);
-            painter.drawEllipse(markRect);
-            QFont f = painter.font(); f.setPointSize(14); f.setBold(true); painter.setFont(f);
-            painter.setPen(Qt::white);
-            painter.drawText(markRect, Qt::AlignCenter, "+");
-            painter.restore();
-        }
-        // C型被B减产：右下角黄色圆底黑色粗体"!"
-        if (m_cell->getType() == AlgaeType::TYPE_C && m_cell->isReducedByNeighborB()) {
-            painter.save();
-            int r = 18;
-            QRect markRect(cellRect.right()-r-2, cellRect.bottom()-r-2, r, r);
-            painter.setBrush(QColor(255,220,0));
-            painter.setPen(Qt::NoPen);
-            painter.drawEllipse(markRect);
-            QFont f = painter.font(); f.setPointSize(14); f.setBold(true); painter.setFont(f);
-            painter.setPen(Qt::black);
-            painter.drawText(markRect, Qt::AlignCenter, "!");
-            painter.restore();
-        }
-        // D型被协同：左下角蓝色圆底白色粗体"★"
-        if (m_cell->getType() == AlgaeType::TYPE_D && m_cell->isSynergizingNeighbor()) {
-            painter.save();
-            int r = 18;
-            QRect markRect(cellRect.left()+2, cellRect.bottom()-r-2, r, r);
-            painter.setBrush(QColor(0,120,255));
-            painter.setPen(Qt::NoPen);
-            painter.drawEllipse(markRect);
-            QFont f = painter.font(); f.setPointSize(14); f.setBold(true); painter.setFont(f);
-            painter.setPen(Qt::white);
-            painter.drawText(markRect, Qt::AlignCenter, "★");
-            painter.restore();
+    GameResources* res = m_game->getResources();
+    LayoutOptimizer::Settings settings;
+    settings.light = m_game->getGrid()->getLightProfile();
+    settings.budget.carb = res->getCarbohydrates();
+    settings.budget.lipid = res->getLipids();
+    settings.budget.pro = res->getProteins();
+    settings.budget.vit = res->getVitamins();
+    settings.seed = QRandomGenerator::global()->generate(); // 每次建议可以不同
+    settings.timeLimitMs = 800; // 整次搜索（所有链合计）限时0.8秒，大网格时界面等待不超过1秒
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    const GridLayout current = GridLayout::fromGrid(*m_game->getGrid());
+    const LayoutOptimizer::Result result = LayoutOptimizer::optimize(current, settings);
+    QApplication::restoreOverrideCursor();
+
+    if (result.changed == 0) {
+        QMessageBox::information(this, tr("布局建议"), tr("在现有资源下没有找到比当前布局更好的方案。"));
+    } else {
+        // result中的产量与消耗按种植规则应用建议后得出（evaluateApplied），预览与应用后的结果一致
+        const GridModel::ProduceSums now = LayoutOptimizer::evaluate(current, settings.light);
+        QString msg = tr("建议改动%1格，共%2株藻类（搜索%3步，用时%4毫秒）。\n\n")
+                          .arg(result.changed).arg(result.planted).arg(result.iterations).arg(qRound(result.elapsedMs));
+        msg += tr("每秒产量：\n  糖类 %1 → %2\t脂质 %3 → %4\n  蛋白质 %5 → %6\t维生素 %7 → %8\n\n")
+                   .arg(now.carb, 0, 'f', 1).arg(result.rates.carb, 0, 'f', 1)
+                   .arg(now.lipid, 0, 'f', 1).arg(result.rates.lipid, 0, 'f', 1)
+                   .arg(now.pro, 0, 'f', 1).arg(result.rates.pro, 0, 'f', 1)
+                   .arg(now.vit, 0, 'f', 1).arg(result.rates.vit, 0, 'f', 1);
+        msg += tr("种植消耗：糖类%1 脂质%2 蛋白质%3 维生素%4\n\n")
+                   .arg(result.cost.carb).arg(result.cost.lipid).arg(result.cost.pro).arg(result.cost.vit);
+        for (int row = 0; row < result.layout.rows; ++row) {
+            QString line;
+            for (int col = 0; col < result.layout.cols; ++col) {
+                line += QLatin1Char(GridLayout::typeToChar(result.layout.at(row, col)));
+            }
+            msg += line + "\n";
         }
-        // 被D型协同的A/B/C型：右下角蓝色圆底白色粗体"↑"
-        if (m_cell->isSynergizedByNeighbor() && m_cell->getType() != AlgaeType::TYPE_D) {
-            painter.save();
-            int r = 18;
-            QRect markRect(cellRect.right()-r-2, cellRect.bottom()-r-2, r, r);
-            painter.setBrush(QColor(0,120,255));
-            painter.setPen(Qt::NoPen);
-            painter.drawEllipse(markRect);
-            QFont f = painter.font(); f.setPointSize(14); f.setBold(true); painter.setFont(f);
-            painter.setPen(Qt::white);
-            painter.drawText(markRect, Qt::AlignCenter, "↑");
-            painter.restore();
+        msg += tr("\n应用这个布局吗？与建议不同的藻类将被移除。");
+        if (QMessageBox::question(this, tr("布局建议"), msg, QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+            const int planted = m_game->applyLayout(result.layout);
+            m_uiScheduler->markDirty(UiScheduler::PANEL_ALL);
+            statusBar()->showMessage(tr("已按建议种下%1株藻类").arg(planted), 3000);
         }
     }
-}
-
-void CellWidget::mousePressEvent(QMouseEvent* event) {
-    if (!m_cell) return;
-    if (event->button() == Qt::LeftButton) {
-        emit leftClicked(m_row, m_col);
-    } else if (event->button() == Qt::RightButton) {
-        emit rightClicked(m_row, m_col);
-    }
-}
 
-void CellWidget::enterEvent(QEnterEvent* event) {
-    Q_UNUSED(event);
-    m_hovered = true;
-    emit hovered(m_row, m_col);
-    update();
-    GameGrid* grid = nullptr;
-    if (m_cell && m_cell->parentWidget()) {
-        grid = qobject_cast<GameGrid*>(m_cell->parentWidget());
-    }
-    if (grid) {
-        int shadeDepth = 2;
-        for (int d = 1; d <= shadeDepth; ++d) {
-            int r = m_row + d;
-            if (r < grid->getRows()) {
-                for (int c = m_col-1; c <= m_col+1; ++c) {
-                    if (c >= 0 && c < grid->getCols()) {
-                        AlgaeCell* cell = grid->getCell(r, c);
-                        if (cell) cell->QWidget::update();
-                    }
-                }
-            }
-        }
+    // 恢复游戏
+    if (wasRunning) {
+        m_game->startGame();
     }
 }
 
-void CellWidget::leaveEvent(QEvent* event) {
-    m_hovered = false;
-    update();
-    QWidget::leaveEvent(event);
-}
-
 // =================== MainWindow实现部分 ===================
 StartWindow::StartWindow(QWidget* parent) : QDialog(parent) {
     setWindowTitle("Algae");
@@ -662,15 +400,7 @@ MainWindow::MainWindow(QWidget *parent)
         return;
     }
 
-    m_progressBar = new QProgressBar(this); // 进度条
-    m_lblCarb = new QLabel(this);           // 糖类标签
-    m_lblLipid = new QLabel(this);          // 脂质标签
-    m_lblPro = new QLabel(this);            // 蛋白质标签
-    m_lblVit = new QLabel(this);            // 维生素标签
-    m_lblCarbRate = new QLabel(this);       // 糖类速率标签
-    m_lblLipidRate = new QLabel(this);      // 脂质速率标签
-    m_lblProRate = new QLabel(this);        // 蛋白质速率标签
-    m_lblVitRate = new QLabel(this);        // 维生素速率标签
+    m_hud = new HudPanel(this);             // 信息面板
     m_btnTypeA = new QPushButton("螺旋藻 Spirulina", this); // 螺旋藻按钮
     m_btnTypeB = new QPushButton("小球藻 Chlorella", this); // 小球藻按钮
     m_btnTypeC = new QPushButton("小型硅藻 Cyclotella", this); // 小型硅藻按钮
@@ -681,19 +411,18 @@ MainWindow::MainWindow(QWidget *parent)
     m_iconTypeC = new QLabel(this); // C型图标
     m_iconTypeD = new QLabel(this); // D型图标
     m_iconTypeE = new QLabel(this); // E型图标
-    m_cellsLayout = new QGridLayout(); // 网格布局
     m_game = new AlgaeGame(this);      // 游戏主逻辑
+    m_game->setRecorder(&m_recorder); // 从启动起录制玩家操作
+    m_uiScheduler = new UiScheduler(this); // 界面刷新调度器
+    // 自动存档写在应用数据目录，序列化与写文件在后台线程完成
+    const QString saveDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(saveDir);
+    m_autoSaver = new AutoSaver(saveDir + "/autosave.algsave", this);
+    m_autoSaveTimer = new QTimer(this);
+    m_autoSaveTimer->setInterval(AUTOSAVE_INTERVAL_MS);
+    m_shownHudValues.fill(std::numeric_limits<double>::quiet_NaN()); // NaN与任何值都不相等，首帧必定刷新
+    m_gridView = new GameGrid(m_game, this); // 网格画布
     m_gridLayout = new QGridLayout();  // 主网格布局
-    m_scoreLabel = new QLabel(this);   // 分数栏
-    m_winConditionGroup = new QGroupBox(this); // 胜利条件分组
-    m_lblCarbCond = new QLabel(this);  // 糖类条件
-    m_lblLipidCond = new QLabel(this); // 脂质条件
-    m_lblProCond = new QLabel(this);   // 蛋白质条件
-    m_lblVitCond = new QLabel(this);   // 维生素条件
-    m_lblCarbRateCond = new QLabel(this); // 糖类速率条件
-    m_lblLipidRateCond = new QLabel(this); // 脂质速率条件
-    m_lblProRateCond = new QLabel(this);   // 蛋白质速率条件
-    m_lblVitRateCond = new QLabel(this);   // 维生素速率条件
     // 初始化鼠标指针
     pixA = QPixmap(":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_a.png");
     pixB = QPixmap(":/resources/st30f0n665joahrrvuj05fechvwkcv10/type_b.png");
@@ -715,32 +444,45 @@ MainWindow::MainWindow(QWidget *parent)
     m_bgmPlayer->setAudioOutput(m_bgmAudio);
     m_bgmPlayer->setLoops(QMediaPlayer::Infinite);
     m_bgmAudio->setVolume(1.0);
-    m_effectPlayer = new QMediaPlayer(this); // 音效播放器
-    m_effectAudio = new QAudioOutput(this);  // 音效输出
-    m_effectPlayer->setAudioOutput(m_effectAudio);
-    m_effectAudio->setVolume(1.0);
     m_lastBgmProgress = -1.0;
-    m_soundEffects.clear();
     // 新增：读取音效音量设置
     QSettings settings("AlgaeGame", "Settings");
     m_effectVolume = settings.value("SFXVolume", 100).toInt() / 100.0;
-    m_effectAudio->setVolume(m_effectVolume);
+    // 音效统一由SoundManager播放，启动时预先解码并建立固定的发声通道
+    SoundManager* sounds = SoundManager::instance();
+    sounds->setVolume(m_effectVolume);
+    sounds->preload(SOUND_PLANTED);
+    sounds->preload(SOUND_DISPLANT);
+    sounds->preload(SOUND_BUZZER);
+    sounds->preload(EFFECT_PATH + "victory.wav", 1);
     setupUI();                // 初始化UI
     setupGameGrid();          // 初始化网格
     setupGameControls();      // 初始化控制按钮
     setupResourceDisplay();   // 初始化资源显示
     setupMenus();             // 初始化菜单
     connectSignals();         // 连接信号槽
-    initializeCellWidgets();  // 初始化格子控件
 
     setWindowTitle(tr("Algae")); // 设置窗口标题
     setMinimumSize(1024, 768); // 最小尺寸
     showFullScreen(); // 启动全屏
+    // 界面刷新按窗口所在显示器的刷新率（不超过调度器的帧率上限）
+    if (screen()) {
+        m_uiScheduler->setRefreshRate(screen()->refreshRate());
+    }
+    if (QWindow* window = windowHandle()) {
+        connect(window, &QWindow::screenChanged, this, [this](QScreen* newScreen) {
+            if (newScreen) m_uiScheduler->setRefreshRate(newScreen->refreshRate());
+        });
+    }
     restartGame(); // 启动自动重开一局
 }
 
 MainWindow::~MainWindow() {
-    // 所有Qt父子关系会自动释放资源
+    // 所有Qt父子关系会自动释放资源；录制器是成员，先于游戏对象析构
+    // 开始界面取消时构造函数提前返回，游戏对象没有创建
+    if (m_game) {
+        m_game->setRecorder(nullptr);
+    }
 }
 
 // 初始化UI布局
@@ -760,77 +502,10 @@ void MainWindow::setupUI() {
     leftLayout->setSpacing(10);
     leftPanel->setStyleSheet("background: rgba(30,30,30,0.75); border-radius: 16px;");
 
-    // 进度条
-    QGroupBox* progressGroup = new QGroupBox("通关进度");
     QFont groupFont; groupFont.setBold(true); groupFont.setPointSize(12);
-    progressGroup->setFont(groupFont);
-    progressGroup->setStyleSheet("QGroupBox { color: #fff; font-size: 15px; font-weight: bold; border: 2px solid #444; border-radius: 10px; margin-top: 8px; background: rgba(40,40,40,0.8); }");
-    QVBoxLayout* progressLayout = new QVBoxLayout(progressGroup);
-    m_progressBar->setMinimumHeight(28);
-    m_progressBar->setStyleSheet("QProgressBar { background: #e3f2fd; color: #222; font-weight: bold; border-radius: 8px; } QProgressBar::chunk { background: #4caf50; border-radius: 8px; }");
-    progressLayout->addWidget(m_progressBar);
-    leftLayout->addWidget(progressGroup);
-
-    // 分数栏
-    m_scoreLabel->setStyleSheet("color: #1976d2; font-weight: bold; font-size: 20px; background: #e3f2fd; border-radius: 10px; padding: 6px;");
-    leftLayout->addWidget(m_scoreLabel);
-    // 新增分数简介信息栏
-    m_scoreHintLabel = new QLabel(this);
-    m_scoreHintLabel->setStyleSheet("color:#ff9800;font-size:16px;font-weight:bold;background:rgba(255,255,255,0.1);border-radius:8px;padding:4px;");
-    leftLayout->addWidget(m_scoreHintLabel);
-    // 新增分数组成详细说明栏
-    m_scoreDetailLabel = new QLabel(this);
-    m_scoreDetailLabel->setStyleSheet("color:#2196f3;font-size:13px;background:rgba(255,255,255,0.08);border-radius:8px;padding:4px;");
-    m_scoreDetailLabel->setWordWrap(true);
-    leftLayout->addWidget(m_scoreDetailLabel);
-
-    // 资源
-    QGroupBox* resourceGroup = new QGroupBox("资源"); resourceGroup->setFont(groupFont);
-    resourceGroup->setStyleSheet("QGroupBox { color: #fff; font-size: 15px; font-weight: bold; border: 2px solid #444; border-radius: 10px; margin-top: 8px; background: rgba(40,40,40,0.8); }");
-    QGridLayout* resourceLayout = new QGridLayout(resourceGroup);
-    auto styleRes = "color: #fff; font-weight:bold; font-size:16px; background: rgba(30,30,30,0.7); border-radius: 8px; padding: 4px;";
-    m_lblCarb->setStyleSheet(styleRes); m_lblLipid->setStyleSheet(styleRes); m_lblPro->setStyleSheet(styleRes); m_lblVit->setStyleSheet(styleRes);
-    resourceLayout->addWidget(new QLabel("糖类:"), 0, 0);
-    resourceLayout->addWidget(m_lblCarb, 0, 1);
-    resourceLayout->addWidget(new QLabel("脂质:"), 1, 0);
-    resourceLayout->addWidget(m_lblLipid, 1, 1);
-    resourceLayout->addWidget(new QLabel("蛋白质:"), 2, 0);
-    resourceLayout->addWidget(m_lblPro, 2, 1);
-    resourceLayout->addWidget(new QLabel("维生素:"), 3, 0);
-    resourceLayout->addWidget(m_lblVit, 3, 1);
-    leftLayout->addWidget(resourceGroup);
-
-    // 生产速率
-    QGroupBox* rateGroup = new QGroupBox("生产速率"); rateGroup->setFont(groupFont);
-    rateGroup->setStyleSheet("QGroupBox { color: #fff; font-size: 15px; font-weight: bold; border: 2px solid #444; border-radius: 10px; margin-top: 8px; background: rgba(40,40,40,0.8); }");
-    QGridLayout* rateLayout = new QGridLayout(rateGroup);
-    auto styleRate = "color: #b2ff59; font-weight:bold; font-size:15px; background: rgba(30,30,30,0.7); border-radius: 8px; padding: 4px;";
-    m_lblCarbRate->setStyleSheet(styleRate); m_lblLipidRate->setStyleSheet(styleRate); m_lblProRate->setStyleSheet(styleRate); m_lblVitRate->setStyleSheet(styleRate);
-    rateLayout->addWidget(new QLabel("糖类/秒:"), 0, 0);
-    rateLayout->addWidget(m_lblCarbRate, 0, 1);
-    rateLayout->addWidget(new QLabel("脂质/秒:"), 1, 0);
-    rateLayout->addWidget(m_lblLipidRate, 1, 1);
-    rateLayout->addWidget(new QLabel("蛋白质/秒:"), 2, 0);
-    rateLayout->addWidget(m_lblProRate, 2, 1);
-    rateLayout->addWidget(new QLabel("维生素/秒:"), 3, 0);
-    rateLayout->addWidget(m_lblVitRate, 3, 1);
-    leftLayout->addWidget(rateGroup);
-
-    // 胜利条件分组
-    m_winConditionGroup->setFont(groupFont);
-    m_winConditionGroup->setStyleSheet("QGroupBox { color: #fff; font-size: 15px; font-weight: bold; border: 2px solid #444; border-radius: 10px; margin-top: 8px; background: rgba(40,40,40,0.8); }");
-    QFont condFont; condFont.setBold(true); condFont.setPointSize(11);
-    m_lblCarbCond->setFont(condFont); m_lblLipidCond->setFont(condFont); m_lblProCond->setFont(condFont); m_lblVitCond->setFont(condFont);
-    m_lblCarbRateCond->setFont(condFont); m_lblLipidRateCond->setFont(condFont); m_lblProRateCond->setFont(condFont); m_lblVitRateCond->setFont(condFont);
-    m_lblCarbCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblLipidCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblProCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblVitCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblCarbRateCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblLipidRateCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblProRateCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    m_lblVitRateCond->setStyleSheet("color:#fff;background:rgba(30,30,30,0.7);border-radius:6px;padding:2px 8px;");
-    leftLayout->addWidget(m_winConditionGroup);
+
+    // 通关进度、分数、资源、生产速率与胜利条件：一个自绘面板
+    leftLayout->addWidget(m_hud);
 
     // 游戏说明
     QGroupBox* infoGroup = new QGroupBox("游戏说明"); infoGroup->setFont(groupFont);
@@ -852,9 +527,14 @@ void MainWindow::setupUI() {
     QFrame* gridFrame = new QFrame(centerPanel);
     gridFrame->setFrameShape(QFrame::StyledPanel);
     gridFrame->setFrameShadow(QFrame::Sunken);
-    m_cellsLayout->setSpacing(4);
-    m_cellsLayout->setContentsMargins(10, 10, 10, 10);
-    gridFrame->setLayout(m_cellsLayout);
+    QVBoxLayout* gridFrameLayout = new QVBoxLayout(gridFrame);
+    gridFrameLayout->setContentsMargins(0, 0, 0, 0);
+    // 网格画布放进滚动区域：画布随区域拉伸，网格大到格子缩到最小仍放不下时才出现滚动条
+    QScrollArea* gridScroll = new QScrollArea(gridFrame);
+    gridScroll->setWidgetResizable(true);
+    gridScroll->setFrameShape(QFrame::NoFrame);
+    gridScroll->setWidget(m_gridView);
+    gridFrameLayout->addWidget(gridScroll);
     centerLayout->addWidget(gridFrame, 1); // 拉伸填满
 
     // 右侧：藻类选择与说明
@@ -931,35 +611,16 @@ void MainWindow::setupUI() {
     mainLayout->addWidget(leftPanel, 2);
     mainLayout->addWidget(centerPanel, 8); // 网格区域最大
     mainLayout->addWidget(rightPanel, 2);
-}
 
-// =================== CellWidget初始化与信号连接 ===================
-void MainWindow::initializeCellWidgets() {
-    m_cellWidgets.resize(m_game && m_game->getGrid() ? m_game->getGrid()->getRows() : 0); // 按行数分配
-    for (int row = 0; m_game && m_game->getGrid() && row < m_game->getGrid()->getRows(); ++row) {
-        m_cellWidgets[row].resize(m_game->getGrid()->getCols()); // 按列数分配
-        for (int col = 0; col < m_game->getGrid()->getCols(); ++col) {
-            CellWidget* cellWidget = new CellWidget(row, col, this); // 创建格子控件
-            m_cellWidgets[row][col] = cellWidget;
-            AlgaeCell* algaeCell = m_game->getGrid()->getCell(row, col); // 获取对应数据单元格
-            if (algaeCell) {
-                cellWidget->setAlgaeCell(algaeCell); // 绑定数据
-                m_cellsLayout->addWidget(cellWidget, row, col); // 加入布局
-                connect(cellWidget, &CellWidget::leftClicked, this, &MainWindow::onCellClicked); // 左键点击
-                connect(cellWidget, &CellWidget::rightClicked, this, &MainWindow::onCellRightClicked); // 右键点击
-                connect(algaeCell, &AlgaeCell::cellChanged, this, [this, row, col]() {
-                    updateCellDisplay(row, col); // 数据变化时刷新显示
-                });
-                connect(cellWidget, &CellWidget::hovered, this, &MainWindow::displayCellInfo); // 悬浮显示资源信息
-            }
-        }
-    }
+    // 状态栏右侧：每帧重绘的格子数（画面稳定时为0）
+    m_repaintLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(m_repaintLabel);
 }
 
 // 初始化网格（数据相关）
 void MainWindow::setupGameGrid() {
-    // 此处不再new m_cellsLayout和m_gridLayout，也不再添加布局，只做数据相关初始化（如有需要可保留数据相关代码）
-    // m_cellsLayout和m_gridLayout的初始化和布局已在setupUI中完成
+    // 此处不再new m_gridLayout，也不再添加布局，只做数据相关初始化（如有需要可保留数据相关代码）
+    // 网格画布与m_gridLayout的初始化和布局已在setupUI中完成
 }
 
 // 初始化控制按钮逻辑
@@ -997,14 +658,9 @@ void MainWindow::setupGameControls() {
 }
 
 // 初始化资源与速率显示
+// 通关进度只随资源与速率变化，跟着它们的面板一起刷新，不再单独定时轮询
 void MainWindow::setupResourceDisplay() {
-    onResourcesChanged();
-    onProductionRatesChanged();
-
-    // 定时刷新通关进度
-    QTimer* progressTimer = new QTimer(this);
-    connect(progressTimer, &QTimer::timeout, this, &MainWindow::updateWinProgress);
-    progressTimer->start(500); // 每0.5秒刷新
+    m_uiScheduler->markDirty(UiScheduler::PANEL_RESOURCES | UiScheduler::PANEL_RATES | UiScheduler::PANEL_PROGRESS);
 }
 
 // 初始化菜单
@@ -1015,18 +671,54 @@ void MainWindow::setupMenus() {
     // 创建菜单动作
     m_restartAction = new QAction(tr("重新开始"), this);
     m_settingsAction = new QAction(tr("设置"), this);
+    m_suggestAction = new QAction(tr("布局建议"), this);
+    m_saveAction = new QAction(tr("保存存档"), this);
+    m_loadAction = new QAction(tr("读取存档"), this);
+    m_replayAction = new QAction(tr("导出操作录像"), this);
     m_exitAction = new QAction(tr("退出"), this);
+    m_saveAction->setShortcut(QKeySequence::Save);
+    m_loadAction->setShortcut(QKeySequence::Open);
 
     // 添加动作到菜单
     m_gameMenu->addAction(m_restartAction);
     m_gameMenu->addAction(m_settingsAction);
+    m_gameMenu->addAction(m_suggestAction);
+    m_gameMenu->addSeparator();
+    m_gameMenu->addAction(m_saveAction);
+    m_gameMenu->addAction(m_loadAction);
+    m_gameMenu->addAction(m_replayAction);
     m_gameMenu->addSeparator();
     m_gameMenu->addAction(m_exitAction);
 
     // 连接菜单动作
     connect(m_restartAction, &QAction::triggered, this, &MainWindow::restartGame);
     connect(m_settingsAction, &QAction::triggered, this, &MainWindow::showSettingsDialog);
+    connect(m_suggestAction, &QAction::triggered, this, &MainWindow::suggestLayout);
+    connect(m_saveAction, &QAction::triggered, this, &MainWindow::saveGame);
+    connect(m_loadAction, &QAction::triggered, this, &MainWindow::loadGame);
+    connect(m_replayAction, &QAction::triggered, this, &MainWindow::exportReplay);
     connect(m_exitAction, &QAction::triggered, this, &MainWindow::exitGame);
+
+    // 模拟速度菜单（快进），Ctrl+1~4切换
+    QMenu* speedMenu = menuBar()->addMenu(tr("速度"));
+    QActionGroup* speedGroup = new QActionGroup(this);
+    const QList<QPair<QString, AlgaeGame::SimSpeed>> speeds = {
+        { tr("1倍速"), AlgaeGame::SPEED_1X },
+        { tr("4倍速"), AlgaeGame::SPEED_4X },
+        { tr("16倍速"), AlgaeGame::SPEED_16X },
+        { tr("最快"), AlgaeGame::SPEED_MAX }
+    };
+    for (int i = 0; i < speeds.size(); ++i) {
+        const AlgaeGame::SimSpeed speed = speeds[i].second;
+        QAction* action = speedMenu->addAction(speeds[i].first);
+        action->setCheckable(true);
+        action->setChecked(m_game->getSimSpeed() == speed);
+        action->setShortcut(QKeySequence(QString("Ctrl+%1").arg(i + 1)));
+        speedGroup->addAction(action);
+        connect(action, &QAction::triggered, this, [this, speed]() {
+            m_game->setSimSpeed(speed);
+        });
+    }
 }
 
 // 连接信号槽
@@ -1036,11 +728,37 @@ void MainWindow::connectSignals() {
     connect(m_game, &AlgaeGame::selectedAlgaeChanged, this, &MainWindow::updateSelectedAlgaeButton);
     connect(m_game, &AlgaeGame::gameWon, this, &MainWindow::onGameWon);
 
-    // 资源信号
-    connect(m_game->getResources(), &GameResources::resourcesChanged, this, &MainWindow::onResourcesChanged);
-    connect(m_game->getResources(),&GameResources::productionRatesChanged, this, &MainWindow::onProductionRatesChanged);
-    // 网格刷新信号
-    connect(m_game->getGrid(), &GameGrid::gridUpdated, this, &MainWindow::updateGridDisplay);
+    // 模型信号只标记脏面板，由调度器每帧统一刷新一次
+    UiScheduler* scheduler = m_uiScheduler;
+    connect(m_game->getResources(), &GameResources::resourcesChanged, scheduler, [scheduler]() {
+        scheduler->markDirty(UiScheduler::PANEL_RESOURCES | UiScheduler::PANEL_PROGRESS);
+    });
+    connect(m_game->getResources(), &GameResources::productionRatesChanged, scheduler, [scheduler]() {
+        scheduler->markDirty(UiScheduler::PANEL_RATES | UiScheduler::PANEL_PROGRESS);
+    });
+    connect(m_game, &AlgaeGame::gridUpdated, scheduler, [scheduler]() {
+        scheduler->markDirty(UiScheduler::PANEL_GRID);
+    });
+    connect(m_game, &AlgaeGame::selectedAlgaeChanged, scheduler, [scheduler]() {
+        scheduler->markDirty(UiScheduler::PANEL_GRID); // 种植提示随选中藻类变化，需重取快照
+    });
+    connect(m_game, &AlgaeGame::cellChanged, scheduler, &UiScheduler::markCellDirty); // 数据变化时刷新显示
+    connect(m_game, &AlgaeGame::gridResized, this, [this]() {
+        m_gridView->rebuild();   // 按新尺寸重新排布格子
+        m_uiScheduler->markDirty(UiScheduler::PANEL_GRID);
+    });
+    connect(m_uiScheduler, &UiScheduler::frame, this, &MainWindow::onUiFrame);
+    connect(m_autoSaveTimer, &QTimer::timeout, this, &MainWindow::autoSave);
+    connect(m_autoSaver, &AutoSaver::saved, this, [this](bool ok, const QString& error) {
+        if (!ok) statusBar()->showMessage(tr("自动存档失败: %1").arg(error), 5000);
+    });
+    m_autoSaveTimer->start();
+    connect(m_gridView, &GameGrid::cellClicked, this, &MainWindow::onCellClicked);           // 左键种植
+    connect(m_gridView, &GameGrid::cellRightClicked, this, &MainWindow::onCellRightClicked); // 右键移除
+    connect(m_gridView, &GameGrid::cellHovered, this, [this](int row, int col, bool entered) {
+        if (entered) displayCellInfo(row, col); // 悬浮显示资源信息
+        updateRepaintCounter();
+    });
 }
 
 // 刷新选中藻类按钮样式
@@ -1076,36 +794,23 @@ void MainWindow::updateSelectedAlgaeButton() {
     }
 }
 
-// 刷新整个网格显示
-void MainWindow::updateGridDisplay() {
-    if (!m_game || !m_game->getGrid()) return;
-    for (int row = 0; row < m_game->getGrid()->getRows(); ++row) {
-        for (int col = 0; col < m_game->getGrid()->getCols(); ++col) {
-            updateCellDisplay(row, col); // 刷新每个格子
-        }
-    }
+// 状态栏显示网格上一帧重绘的格子数
+void MainWindow::updateRepaintCounter() {
+    if (!m_repaintLabel) return;
+    const QString text = QString("重绘格子: %1/帧").arg(m_gridView->getLastFrameCells());
+    if (m_repaintLabel->text() != text) m_repaintLabel->setText(text);
 }
 
-// 刷新单个格子显示
-void MainWindow::updateCellDisplay(int row, int col) {
-    if (!m_game || !m_game->getGrid()) return;
-    if (row < m_cellWidgets.size() && col < m_cellWidgets[row].size()) {
-        AlgaeCell* cell = m_game->getGrid()->getCell(row, col);
-        if (cell) m_cellWidgets[row][col]->setAlgaeCell(cell);
-    }
-}
-
-// 显示单元格信息到状态栏和气泡
+// 显示单元格信息到状态栏和气泡（数据取自网格本帧的渲染快照）
 void MainWindow::displayCellInfo(int row, int col) {
-    if (!m_game || !m_game->getGrid()) return;
-    GameGrid* grid = m_game->getGrid();
-    AlgaeCell* cell = grid->getCell(row, col);
-    if (cell) {
-        double light = grid->getLightAt(row, col);
-        AlgaeType::Type selType = m_game->getSelectedAlgaeType();
+    if (!m_gridView) return;
+    const RenderSnapshot& snapshot = m_gridView->snapshot();
+    if (snapshot.contains(row, col)) {
+        double light = snapshot.lightAt(row, col);
+        AlgaeType::Type selType = snapshot.getSelectedType();
         QString lightReqText;
         if (selType != AlgaeType::NONE) {
-            auto props = AlgaeType::getProperties(selType);
+            const auto& props = AlgaeType::getProperties(selType);
             lightReqText = QString("（种植≥%1，维持≥%2，存活≥%3）")
                 .arg(props.lightRequiredPlant)
                 .arg(props.lightRequiredMaintain)
@@ -1124,8 +829,8 @@ void MainWindow::displayCellInfo(int row, int col) {
         QString info = QString("位置: (%1,%2)  氮素: %3  二氧化碳: %4  光照: %5 %6")
             .arg(row)
             .arg(col)
-            .arg(QString::number(grid->getNitrogenAt(row, col), 'f', 1))
-            .arg(QString::number(grid->getCarbonAt(row, col), 'f', 1))
+            .arg(QString::number(snapshot.nitrogenAt(row, col), 'f', 1))
+            .arg(QString::number(snapshot.carbonAt(row, col), 'f', 1))
             .arg(QString::number(light, 'f', 1))
             .arg(lightReqText);
         statusBar()->showMessage(info, 2000);
@@ -1133,20 +838,9 @@ void MainWindow::displayCellInfo(int row, int col) {
     }
 }
 
-// 播放音效（临时播放器）
+// 播放音效（音效池中的空闲通道）
 void MainWindow::playSoundEffect(const QString& resource) {
-    auto player = new QMediaPlayer(this);
-    auto audio = new QAudioOutput(this);
-    audio->setVolume(m_effectVolume);
-    player->setAudioOutput(audio);
-    player->setSource(QUrl(resource));
-    player->play();
-    connect(player, &QMediaPlayer::mediaStatusChanged, player, [player, audio](QMediaPlayer::MediaStatus status){
-        if (status == QMediaPlayer::EndOfMedia || status == QMediaPlayer::InvalidMedia) {
-            player->deleteLater();
-            audio->deleteLater();
-        }
-    });
+    SoundManager::instance()->playSoundEffect(resource);
 }
 
 // 单元格左键点击事件
@@ -1154,21 +848,71 @@ void MainWindow::onCellClicked(int row, int col) {
     bool success = m_game->plantAlgae(row, col);
     if (success) {
         statusBar()->showMessage(tr("放置藻类在 (%1,%2)").arg(row).arg(col), 2000);
-        playSoundEffect("qrc:/resources/planted.mp3");
+        playSoundEffect(SOUND_PLANTED);
     } else {
-        playSoundEffect("qrc:/resources/buzzer.wav");
+        playSoundEffect(SOUND_BUZZER);
     }
-    updateCellDisplay(row, col);
+    m_uiScheduler->markCellDirty(row, col);
 }
 
 // 单元格右键点击事件
 void MainWindow::onCellRightClicked(int row, int col) {
     bool success = m_game->removeAlgae(row, col);
     if (success) {
-        playSoundEffect("qrc:/resources/displant.wav");
+        playSoundEffect(SOUND_DISPLANT);
         statusBar()->showMessage(tr("移除藻类，恢复周围资源"), 2000);
     } else {
-        playSoundEffect("qrc:/resources/buzzer.wav");
+        playSoundEffect(SOUND_BUZZER);
+    }
+}
+
+// 保存存档：取当前状态写入用户选择的文件
+void MainWindow::saveGame() {
+    const QString path = QFileDialog::getSaveFileName(this, tr("保存存档"), m_autoSaver->getPath(), tr("藻类存档 (*.algsave)"));
+    if (path.isEmpty()) return;
+    QString error;
+    if (SaveGame::fromGame(*m_game).save(path, &error)) {
+        statusBar()->showMessage(tr("已保存存档 %1").arg(path), 3000);
+    } else {
+        QMessageBox::warning(this, tr("保存存档"), tr("保存失败：%1").arg(error));
+    }
+}
+
+// 读取存档：校验通过后整体替换游戏状态（游戏暂停）
+void MainWindow::loadGame() {
+    const QString path = QFileDialog::getOpenFileName(this, tr("读取存档"), m_autoSaver->getPath(), tr("藻类存档 (*.algsave)"));
+    if (path.isEmpty()) return;
+    m_autoSaver->waitForIdle(); // 读的可能正是自动存档
+    SaveGame save;
+    QString error;
+    if (!save.load(path, &error) || !m_game->loadSave(save)) {
+        QMessageBox::warning(this, tr("读取存档"), tr("读取失败：%1").arg(error.isEmpty() ? tr("存档数据无效") : error));
+        return;
+    }
+    m_hasShownWinMsg = false;
+    m_uiScheduler->markDirty(UiScheduler::PANEL_ALL);
+    statusBar()->showMessage(tr("已读取存档 %1").arg(path), 3000);
+}
+
+// 自动存档：界面线程只复制状态，序列化与写文件交给后台线程
+void MainWindow::autoSave() {
+    if (m_game->isGameRunning()) {
+        // 复用上一份写完的缓冲，界面线程上只按行复制状态，不重新分配
+        std::unique_ptr<SaveGame> save = m_autoSaver->takeBuffer();
+        save->capture(*m_game);
+        m_autoSaver->submit(std::move(save));
+    }
+}
+
+// 导出操作录像：可用 algaeplus-sim --replay 无界面回放
+void MainWindow::exportReplay() {
+    const QString path = QFileDialog::getSaveFileName(this, tr("导出操作录像"), QString(), tr("操作录像 (*.algreplay)"));
+    if (path.isEmpty()) return;
+    QString error;
+    if (m_recorder.save(*m_game, path, &error)) {
+        statusBar()->showMessage(tr("已导出操作录像 %1").arg(path), 3000);
+    } else {
+        QMessageBox::warning(this, tr("导出操作录像"), tr("导出失败：%1").arg(error));
     }
 }
 
@@ -1182,160 +926,64 @@ void MainWindow::onGameStateChanged() {
     }
 }
 
-// 资源变化槽
-void MainWindow::onResourcesChanged() {
-    GameResources* resources = m_game->getResources();
-    // 目标值
-    const double WIN_CARB = 500.0;
-    const double WIN_LIPID = 300.0;
-    const double WIN_PRO = 200.0;
-    const double WIN_VIT = 100.0;
-    // 当前值
-    double c = resources->getCarbohydrates();
-    double l = resources->getLipids();
-    double p = resources->getProteins();
-    double v = resources->getVitamins();
-    // 达标判断
-    auto resStyle = [](bool ok) { return ok ? "color:#2ecc40;font-weight:bold;" : "color:#e67e22;"; };
-    m_lblCarb->setText(QString("%1 / %2 %3").arg(QString::number(c, 'f', 1)).arg(WIN_CARB, 0, 'f', 0).arg(c >= WIN_CARB ? "✅" : "❌"));
-    m_lblCarb->setStyleSheet(resStyle(c >= WIN_CARB));
-    m_lblLipid->setText(QString("%1 / %2 %3").arg(QString::number(l, 'f', 1)).arg(WIN_LIPID, 0, 'f', 0).arg(l >= WIN_LIPID ? "✅" : "❌"));
-    m_lblLipid->setStyleSheet(resStyle(l >= WIN_LIPID));
-    m_lblPro->setText(QString("%1 / %2 %3").arg(QString::number(p, 'f', 1)).arg(WIN_PRO, 0, 'f', 0).arg(p >= WIN_PRO ? "✅" : "❌"));
-    m_lblPro->setStyleSheet(resStyle(p >= WIN_PRO));
-    m_lblVit->setText(QString("%1 / %2 %3").arg(QString::number(v, 'f', 1)).arg(WIN_VIT, 0, 'f', 0).arg(v >= WIN_VIT ? "✅" : "❌"));
-    m_lblVit->setStyleSheet(resStyle(v >= WIN_VIT));
-    updateWinProgress();
-    updateWinConditionLabels();
-    updateScoreBar();
-    // 移除全局刷新，提高性能
-    // onProductionRatesChanged();
-}
-
-// 生产速率变化槽
-void MainWindow::onProductionRatesChanged() {
-    GameResources* resources = m_game->getResources();
-    // 目标速率
-    const double TARGET_CARB_RATE = 50.0;
-    const double TARGET_LIPID_RATE = 30.0;
-    const double TARGET_PRO_RATE = 20.0;
-    const double TARGET_VIT_RATE = 10.0;
-    double cr = resources->getCarbRate();
-    double lr = resources->getLipidRate();
-    double pr = resources->getProRate();
-    double vr = resources->getVitRate();
-    auto rateStyle = [](bool ok) { return ok ? "color:#b2ff59;font-weight:bold;" : "color:#e67e22;"; };
-    m_lblCarbRate->setText(QString("%1 / %2 %3").arg(QString::number(cr, 'f', 1)).arg(TARGET_CARB_RATE, 0, 'f', 0).arg(cr >= TARGET_CARB_RATE ? "✅" : "❌"));
-    m_lblCarbRate->setStyleSheet(rateStyle(cr >= TARGET_CARB_RATE));
-    m_lblLipidRate->setText(QString("%1 / %2 %3").arg(QString::number(lr, 'f', 1)).arg(TARGET_LIPID_RATE, 0, 'f', 0).arg(lr >= TARGET_LIPID_RATE ? "✅" : "❌"));
-    m_lblLipidRate->setStyleSheet(rateStyle(lr >= TARGET_LIPID_RATE));
-    m_lblProRate->setText(QString("%1 / %2 %3").arg(QString::number(pr, 'f', 1)).arg(TARGET_PRO_RATE, 0, 'f', 0).arg(pr >= TARGET_PRO_RATE ? "✅" : "❌"));
-    m_lblProRate->setStyleSheet(rateStyle(pr >= TARGET_PRO_RATE));
-    m_lblVitRate->setText(QString("%1 / %2 %3").arg(QString::number(vr, 'f', 1)).arg(TARGET_VIT_RATE, 0, 'f', 0).arg(vr >= TARGET_VIT_RATE ? "✅" : "❌"));
-    m_lblVitRate->setStyleSheet(rateStyle(vr >= TARGET_VIT_RATE));
-    // 不再全局刷新网格
-}
+// 调度器每帧调用一次：网格按脏标记刷新，信息面板先比较数据，数据没变时整块跳过
+void MainWindow::onUiFrame(int panels, const QList<QPoint>& cells) {
+    if (panels & UiScheduler::PANEL_GRID) {
+        m_gridView->refresh();
+        updateRepaintCounter();
+    } else if (panels & UiScheduler::PANEL_CELLS) {
+        m_gridView->refreshCells(cells);
+        updateRepaintCounter();
+    }
 
-// 刷新通关进度条
-void MainWindow::updateWinProgress() {
-    double progress = m_game->getResources()->getWinProgress();
-    m_progressBar->setValue(static_cast<int>(progress * 100));
-    playBGM(progress);
-    // 根据进度改变颜色
-    QString styleSheet;
-    if (progress < 0.3) {
-        styleSheet = "QProgressBar { text-align: center; } QProgressBar::chunk { background-color: #ff3333; }";
-    } else if (progress < 0.7) {
-        styleSheet = "QProgressBar { text-align: center; } QProgressBar::chunk { background-color: #ffcc33; }";
-    } else {
-        styleSheet = "QProgressBar { text-align: center; } QProgressBar::chunk { background-color: #33cc33; }";
+    if (panels & (UiScheduler::PANEL_RESOURCES | UiScheduler::PANEL_RATES | UiScheduler::PANEL_PROGRESS)) {
+        GameResources* res = m_game->getResources();
+        const std::array<double, 8> values = { res->getCarbohydrates(), res->getLipids(), res->getProteins(), res->getVitamins(),
+                                               res->getCarbRate(), res->getLipidRate(), res->getProRate(), res->getVitRate() };
+        if (values != m_shownHudValues) {
+            m_shownHudValues = values;
+            updateHud();
+        }
     }
-    m_progressBar->setStyleSheet(styleSheet);
 }
 
-// 刷新胜利条件标签
-void MainWindow::updateWinConditionLabels() {
+// 刷新信息面板：评分公式与onGameWon一致，面板内部只重绘数值变化的区域
+void MainWindow::updateHud() {
     GameResources* res = m_game->getResources();
-    // 目标值
-    const double WIN_CARB = 500.0;
-    const double WIN_LIPID = 300.0;
-    const double WIN_PRO = 200.0;
-    const double WIN_VIT = 100.0;
-    const double TARGET_CARB_RATE = 50.0;
-    const double TARGET_LIPID_RATE = 30.0;
-    const double TARGET_PRO_RATE = 20.0;
-    const double TARGET_VIT_RATE = 10.0;
-    // 当前值
-    double c = res->getCarbohydrates();
-    double l = res->getLipids();
-    double p = res->getProteins();
-    double v = res->getVitamins();
-    double cr = res->getCarbRate();
-    double lr = res->getLipidRate();
-    double pr = res->getProRate();
-    double vr = res->getVitRate();
-    // 设置文本和颜色
-    auto setLabel = [](QLabel* lbl, double val, double target, const QString& name) {
-        bool ok = val >= target;
-        lbl->setText(QString("%1：%2 / %3 %4").arg(name).arg(val, 0, 'f', 1).arg(target, 0, 'f', 1).arg(ok ? "✅" : "❌"));
-        lbl->setStyleSheet(ok ? "color: #2ecc40; font-weight:bold;" : "color: #e67e22;");
-    };
-    setLabel(m_lblCarbCond, c, WIN_CARB, "糖类");
-    setLabel(m_lblLipidCond, l, WIN_LIPID, "脂质");
-    setLabel(m_lblProCond, p, WIN_PRO, "蛋白质");
-    setLabel(m_lblVitCond, v, WIN_VIT, "维生素");
-    setLabel(m_lblCarbRateCond, cr, TARGET_CARB_RATE, "糖类速率");
-    setLabel(m_lblLipidRateCond, lr, TARGET_LIPID_RATE, "脂质速率");
-    setLabel(m_lblProRateCond, pr, TARGET_PRO_RATE, "蛋白质速率");
-    setLabel(m_lblVitRateCond, vr, TARGET_VIT_RATE, "维生素速率");
-}
-
-// 刷新分数栏
-void MainWindow::updateScoreBar() {
-    // 评分公式与onGameWon一致
-    double carb = m_game->getResources()->getCarbohydrates();
-    double lipid = m_game->getResources()->getLipids();
-    double pro = m_game->getResources()->getProteins();
-    double vit = m_game->getResources()->getVitamins();
-    double cr = m_game->getResources()->getCarbRate();
-    double lr = m_game->getResources()->getLipidRate();
-    double pr = m_game->getResources()->getProRate();
-    double vr = m_game->getResources()->getVitRate();
-    double resourceScore = (carb/500.0 + lipid/300.0 + pro/200.0 + vit/100.0) / 4.0 * 50.0;
-    double rateScore = (cr/50.0 + lr/30.0 + pr/20.0 + vr/10.0) / 4.0 * 50.0;
+    HudPanel::Snapshot snapshot;
+    snapshot.resources[0] = res->getCarbohydrates();
+    snapshot.resources[1] = res->getLipids();
+    snapshot.resources[2] = res->getProteins();
+    snapshot.resources[3] = res->getVitamins();
+    snapshot.rates[0] = res->getCarbRate();
+    snapshot.rates[1] = res->getLipidRate();
+    snapshot.rates[2] = res->getProRate();
+    snapshot.rates[3] = res->getVitRate();
+    snapshot.progress = res->getWinProgress();
+
+    const double* r = snapshot.resources;
+    const double* v = snapshot.rates;
+    double resourceScore = (r[0]/500.0 + r[1]/300.0 + r[2]/200.0 + r[3]/100.0) / 4.0 * 50.0;
+    double rateScore = (v[0]/50.0 + v[1]/30.0 + v[2]/20.0 + v[3]/10.0) / 4.0 * 50.0;
     int totalScore = static_cast<int>(resourceScore + rateScore + 0.5);
     if (totalScore >= 100) {
         resourceScore = 0.0;
         totalScore = static_cast<int>(rateScore + 0.5);
     }
     // 检查是否完全达标
-    bool isFullWin = m_game->getResources()->checkWinCondition();
+    bool isFullWin = res->checkWinCondition();
     if (!isFullWin) {
         totalScore /= 2; // 未完全达标分数减半
     }
     if (totalScore > m_highScore) m_highScore = totalScore;
-    m_scoreLabel->setText(QString("分数：%1   最高分：%2").arg(totalScore).arg(m_highScore));
-    // 新增分数简介信息栏内容
-    QString hint;
-    if (!isFullWin) hint = "当前未完全达标，分数已减半！";
-    else if (totalScore < 60) hint = "继续努力，优化藻类布局！";
-    else if (totalScore < 80) hint = "良好，距离目标不远了！";
-    else if (totalScore < 100) hint = "优秀，快达成极限生产！";
-    else hint = "极限挑战，追求更高分数！";
-    m_scoreHintLabel->setText(hint);
-    // 新增分数组成详细说明
-    QString detail = QString(
-        "当前分数组成：\n"
-        "资源得分：%1\n"
-        "速率得分：%2\n"
-        "总分：%3\n"
-        "资源得分 = (糖/500 + 脂/300 + 蛋白/200 + 维生素/100) / 4 × 50\n"
-        "速率得分 = (糖速/50 + 脂速/30 + 蛋白速/20 + 维生素速/10) / 4 × 50\n"
-        "总分 = 资源得分 + 速率得分（满100分后只看速率得分）"
-    ).arg(QString::number(resourceScore, 'f', 1))
-     .arg(QString::number(rateScore, 'f', 1))
-     .arg(QString::number(totalScore));
-    m_scoreDetailLabel->setText(detail);
+    snapshot.score = totalScore;
+    snapshot.highScore = m_highScore;
+    snapshot.resourceScore = resourceScore;
+    snapshot.rateScore = rateScore;
+    snapshot.fullWin = isFullWin;
+    m_hud->setSnapshot(snapshot);
+
+    playBGM(snapshot.progress);
 }
 
 // 播放背景音乐，根据进度切换曲目
@@ -1352,12 +1000,9 @@ void MainWindow::playBGM(double progress) {
     m_lastBgmProgress = progress;
 }
 
-// 播放音效（主播放器）
+// 播放音效（按文件名）
 void MainWindow::playEffect(const QString& name) {
-    QString path = "qrc:/resources/st30f0n665joahrrvuj05fechvwkcv10/" + name;
-    m_effectAudio->setVolume(m_effectVolume);
-    m_effectPlayer->setSource(QUrl(path));
-    m_effectPlayer->play();
+    SoundManager::instance()->playSoundEffect(EFFECT_PATH + name);
 }
 
 // 详细特性说明弹窗实现
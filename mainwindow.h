@@ -5,12 +5,12 @@
 #include <QGridLayout>    // Qt网格布局
 #include <QPushButton>    // 按钮控件
 #include <QLabel>         // 标签控件
-#include <QProgressBar>   // 进度条控件
 #include <QSlider>        // 滑块控件
 #include <QGridLayout>    // 网格布局
 #include <QMenu>          // 菜单
 #include <QAction>        // 动作
 #include "algaegame.h"   // 游戏主逻辑类
+#include "gamegrid.h"    // 网格视图
 #include <QMenuBar>       // 菜单栏
 #include <QGroupBox>      // 分组框
 #include <QCursor>        // 鼠标指针
@@ -21,8 +21,12 @@
 #include <QScrollArea>    // 滚动区域
 #include <QPixmap>         // 像素图
 #include <QDialog>
-
-class CellWidget; // 前置声明，格子控件
+#include <QTimer>         // 定时器
+#include <array>
+#include "uischeduler.h" // 界面刷新调度器
+#include "hudpanel.h"    // 自绘信息面板
+#include "autosaver.h"   // 后台自动存档
+#include "replayrecorder.h" // 操作录制器
 
 // 主窗口类，负责UI和游戏交互
 class MainWindow : public QMainWindow {
@@ -45,24 +49,27 @@ private slots:
     void onCellClicked(int row, int col);        // 单元格左键点击槽
     void onCellRightClicked(int row, int col);   // 单元格右键点击槽
     void onGameStateChanged();                   // 游戏状态变化槽
-    void onResourcesChanged();                   // 资源变化槽
-    void onProductionRatesChanged();             // 生产速率变化槽
+    void onUiFrame(int panels, const QList<QPoint>& cells); // 每帧一次，刷新调度器标记的面板
     void showGameMenu();                         // 显示菜单
     void restartGame();                          // 重新开始
     void exitGame();                             // 退出游戏
     void showSettingsDialog();                   // 显示设置对话框
-    void updateWinProgress();                    // 刷新通关进度
+    void suggestLayout();                        // 布局建议（搜索并可一键应用）
+    void saveGame();                             // 保存存档
+    void loadGame();                             // 读取存档
+    void autoSave();                             // 定时自动存档（后台线程写入）
+    void exportReplay();                         // 导出本次运行的操作录像
     void onGameWon();                            // 游戏胜利槽
     void showTraitDetailDialog();                 // 显示详细特性说明弹窗
 
 private:
-    AlgaeGame* m_game; // 游戏主逻辑指针
+    AlgaeGame* m_game = nullptr; // 游戏主逻辑指针（开始界面取消时保持为空）
+    GameGrid* m_gridView = nullptr; // 网格画布（所有格子在一个控件中绘制）
 
     // UI组件
     QWidget* m_centralWidget;      // 中央控件
     QGridLayout* m_gridLayout;     // 主网格布局
-    QGridLayout* m_cellsLayout;    // 游戏格子布局
-    QVector<QVector<CellWidget*>> m_cellWidgets; // 格子控件二维数组
+    QLabel* m_repaintLabel = nullptr; // 状态栏：每帧重绘的格子数
 
     // 游戏控制按钮
     QPushButton* m_btnTypeA; // 选择A型藻类
@@ -71,38 +78,19 @@ private:
     QPushButton* m_btnTypeD; // 选择D型藻类
     QPushButton* m_btnTypeE;
 
-    // 资源显示
-    QLabel* m_lblCarb;   // 糖类
-    QLabel* m_lblLipid;  // 脂质
-    QLabel* m_lblPro;    // 蛋白质
-    QLabel* m_lblVit;    // 维生素
-
-    // 生产速率显示
-    QLabel* m_lblCarbRate;   // 糖类速率
-    QLabel* m_lblLipidRate;  // 脂质速率
-    QLabel* m_lblProRate;    // 蛋白质速率
-    QLabel* m_lblVitRate;    // 维生素速率
-
-    // 通关进度
-    QProgressBar* m_progressBar; // 进度条
+    // 资源、速率、通关进度、分数与胜利条件（自绘面板）
+    HudPanel* m_hud;
 
     // 菜单
     QMenu* m_gameMenu;       // 游戏菜单
     QAction* m_restartAction;// 重新开始动作
     QAction* m_settingsAction;// 设置动作
+    QAction* m_suggestAction; // 布局建议动作
+    QAction* m_saveAction;   // 保存存档动作
+    QAction* m_loadAction;   // 读取存档动作
+    QAction* m_replayAction; // 导出操作录像动作
     QAction* m_exitAction;   // 退出动作
 
-    // 胜利条件显示
-    QGroupBox* m_winConditionGroup; // 条件分组
-    QLabel* m_lblCarbCond;   // 糖类条件
-    QLabel* m_lblLipidCond;  // 脂质条件
-    QLabel* m_lblProCond;    // 蛋白质条件
-    QLabel* m_lblVitCond;    // 维生素条件
-    QLabel* m_lblCarbRateCond; // 糖类速率条件
-    QLabel* m_lblLipidRateCond;// 脂质速率条件
-    QLabel* m_lblProRateCond;  // 蛋白质速率条件
-    QLabel* m_lblVitRateCond;  // 维生素速率条件
-
     // 藻类选择图标
     QLabel* m_iconTypeA; // A型图标
     QLabel* m_iconTypeB; // B型图标
@@ -119,7 +107,6 @@ private:
     // 新增：五种藻类图标pixmap
     QPixmap pixA, pixB, pixC, pixD, pixE;
 
-    QLabel* m_scoreLabel; // 实时分数栏
     int m_highScore = 0; // 最高分
 
     bool m_hasShownWinMsg = false; // 胜利提示是否已弹出
@@ -127,21 +114,22 @@ private:
 
     QMediaPlayer* m_bgmPlayer = nullptr; // 背景音乐播放器
     QAudioOutput* m_bgmAudio = nullptr;  // 背景音乐输出
-    QMediaPlayer* m_effectPlayer = nullptr; // 音效播放器
-    QAudioOutput* m_effectAudio = nullptr;  // 音效输出
     double m_lastBgmProgress = -1.0; // 上次BGM进度
 
-    QMap<QString, QSoundEffect*> m_soundEffects; // 音效字典
-
-    QLabel* m_scoreHintLabel;   // 分数评价简介信息栏
-    QLabel* m_scoreDetailLabel; // 分数组成详细说明
-
     QLabel* m_traitInfoLabel; // 植株特性信息栏
     QScrollArea* m_traitInfoScrollArea; // 特性信息滚动区域
     QPushButton* m_btnTraitDetail; // 详细特性说明按钮
 
     double m_effectVolume = 1.0; // 新增，音效音量（0.0~1.0）
 
+    UiScheduler* m_uiScheduler = nullptr; // 界面刷新调度器，合并一帧内的模型通知
+    AutoSaver* m_autoSaver = nullptr;     // 后台自动存档
+    QTimer* m_autoSaveTimer = nullptr;    // 自动存档定时器（游戏运行时每AUTOSAVE_INTERVAL_MS一次）
+    static const int AUTOSAVE_INTERVAL_MS = 60000;
+    ReplayRecorder m_recorder;            // 操作录制器，程序启动起录下玩家的全部操作，用于复现问题
+    // 信息面板上次刷新时的资源与速率（初始为NaN），没变时整块跳过
+    std::array<double, 8> m_shownHudValues;
+
     void setupUI();                // 初始化UI
     void setupGameGrid();          // 初始化网格
     void setupGameControls();      // 初始化控制按钮
@@ -149,44 +137,12 @@ private:
     void setupMenus();             // 初始化菜单
     void connectSignals();         // 连接信号槽
     void updateSelectedAlgaeButton(); // 刷新选中按钮
-    void updateGridDisplay();         // 刷新网格显示
-    void updateCellDisplay(int row, int col); // 刷新单元格显示
+    void updateRepaintCounter();      // 刷新状态栏的每帧重绘格子数
     void displayCellInfo(int row, int col);   // 显示单元格信息
-    void initializeCellWidgets();             // 初始化格子控件
-    void updateWinConditionLabels();          // 刷新胜利条件标签
-    void updateScoreBar();                    // 刷新分数栏
+    void updateHud();                         // 按当前资源与速率刷新信息面板（含分数）
     void playBGM(double progress);            // 播放背景音乐
 };
 
-// 网格格子控件，负责单元格UI显示与交互
-class CellWidget : public QWidget {
-    Q_OBJECT
-
-public:
-    CellWidget(int row, int col, QWidget* parent = nullptr); // 构造函数
-    void setAlgaeCell(AlgaeCell* cell); // 设置对应的藻类单元格
-    int getRow() const { return m_row; } // 获取行号
-    int getCol() const { return m_col; } // 获取列号
-    bool isHovered() const { return m_hovered; } // 是否悬浮
-
-signals:
-    void leftClicked(int row, int col);   // 左键点击信号
-    void rightClicked(int row, int col);  // 右键点击信号
-    void hovered(int row, int col);       // 悬浮信号
-
-protected:
-    void paintEvent(QPaintEvent* event) override;      // 绘制事件
-    void mousePressEvent(QMouseEvent* event) override; // 鼠标点击事件
-    void enterEvent(QEnterEvent* event) override;      // 鼠标进入事件
-    void leaveEvent(QEvent* event) override;           // 鼠标离开事件
-
-private:
-    int m_row;           // 行号
-    int m_col;           // 列号
-    AlgaeCell* m_cell = nullptr; // 对应的藻类单元格
-    bool m_hovered = false;      // 是否悬浮
-};
-
 // 启动界面窗口类
 class StartWindow : public QDialog {
     Q_OBJECT
@@ -0,0 +1,279 @@
+#include "nutrientkernel.h" // 营养计算内核头文件
+#include <QtGlobal>           // qMin/qMax
+#include <cstring>            // memcpy
+#include "cellstate.h"        // 单元格状态枚举
+
+// 向量实现只在x86-64上编译（该平台保证支持SSE2），其他平台只有标量版
+#if defined(__x86_64__) || defined(_M_X64)
+#define NUTRIENT_KERNEL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // __cpuidex/_xgetbv
+#define NUTRIENT_TARGET_AVX2
+#else
+#define NUTRIENT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+// 消耗减半的状态
+inline bool isLowStatus(quint8 status) {
+    return status == CellState::RESOURCE_LOW || status == CellState::LIGHT_LOW;
+}
+
+// ---------- 标量实现（向量实现的尾部也用它处理） ----------
+
+void consumeScalar(double* nitrogen, double* carbon, quint8* status,
+                   const double* consumeN, const double* consumeC,
+                   double deltaTime, int begin, int end)
+{
+    for (int k = begin; k < end; ++k) {
+        const double nNeed = consumeN[k] * deltaTime; // 需要消耗的氮
+        const double cNeed = consumeC[k] * deltaTime; // 需要消耗的碳
+        if (nitrogen[k] < nNeed || carbon[k] < cNeed) {
+            status[k] = CellState::RESOURCE_LOW; // 资源不足
+        } else {
+            status[k] = CellState::NORMAL; // 正常
+            nitrogen[k] -= nNeed;
+            carbon[k] -= cNeed;
+        }
+    }
+}
+
+void regenerateScalar(double* nitrogen, double* carbon, const quint8* status,
+                      const double* regenN, const double* regenC,
+                      const double* consumeN, const double* consumeC,
+                      double deltaTime, int begin, int end)
+{
+    for (int k = begin; k < end; ++k) {
+        double nitrogenConsumption = consumeN[k] * deltaTime;
+        double carbonConsumption = consumeC[k] * deltaTime;
+        if (isLowStatus(status[k])) {
+            nitrogenConsumption *= 0.5;
+            carbonConsumption *= 0.5;
+        }
+        const double n = qMin(NutrientKernel::MAX_NITROGEN, nitrogen[k] + regenN[k] * deltaTime - nitrogenConsumption);
+        const double c = qMin(NutrientKernel::MAX_CARBON, carbon[k] + regenC[k] * deltaTime - carbonConsumption);
+        nitrogen[k] = qMax(0.0, n);
+        carbon[k] = qMax(0.0, c);
+    }
+}
+
+#ifdef NUTRIENT_KERNEL_X86
+
+// 说明：比较用“不小于”（NLT，无序时为真）对应标量的!(a < b)；
+// min(上限, x)/max(x, 0)的参数顺序与qMin/qMax一致，NaN与±0的结果也相同
+
+// ---------- SSE2实现，每次2格 ----------
+
+inline __m128d selectSse2(__m128d mask, __m128d ifTrue, __m128d ifFalse) {
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+void consumeSse2(double* nitrogen, double* carbon, quint8* status,
+                 const double* consumeN, const double* consumeC,
+                 double deltaTime, int count)
+{
+    const __m128d dt = _mm_set1_pd(deltaTime);
+    int k = 0;
+    for (; k + 2 <= count; k += 2) {
+        const __m128d n = _mm_loadu_pd(nitrogen + k);
+        const __m128d c = _mm_loadu_pd(carbon + k);
+        const __m128d nNeed = _mm_mul_pd(_mm_loadu_pd(consumeN + k), dt);
+        const __m128d cNeed = _mm_mul_pd(_mm_loadu_pd(consumeC + k), dt);
+        const __m128d enough = _mm_and_pd(_mm_cmpnlt_pd(n, nNeed), _mm_cmpnlt_pd(c, cNeed));
+        _mm_storeu_pd(nitrogen + k, selectSse2(enough, _mm_sub_pd(n, nNeed), n));
+        _mm_storeu_pd(carbon + k, selectSse2(enough, _mm_sub_pd(c, cNeed), c));
+        const int bits = _mm_movemask_pd(enough);
+        status[k] = (bits & 1) ? CellState::NORMAL : CellState::RESOURCE_LOW;
+        status[k + 1] = (bits & 2) ? CellState::NORMAL : CellState::RESOURCE_LOW;
+    }
+    consumeScalar(nitrogen, carbon, status, consumeN, consumeC, deltaTime, k, count);
+}
+
+void regenerateSse2(double* nitrogen, double* carbon, const quint8* status,
+                    const double* regenN, const double* regenC,
+                    const double* consumeN, const double* consumeC,
+                    double deltaTime, int count)
+{
+    const __m128d dt = _mm_set1_pd(deltaTime);
+    const __m128d half = _mm_set1_pd(0.5);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d maxN = _mm_set1_pd(NutrientKernel::MAX_NITROGEN);
+    const __m128d maxC = _mm_set1_pd(NutrientKernel::MAX_CARBON);
+    int k = 0;
+    for (; k + 2 <= count; k += 2) {
+        const __m128d low = _mm_castsi128_pd(_mm_set_epi64x(isLowStatus(status[k + 1]) ? -1 : 0,
+                                                            isLowStatus(status[k]) ? -1 : 0));
+        __m128d nCons = _mm_mul_pd(_mm_loadu_pd(consumeN + k), dt);
+        __m128d cCons = _mm_mul_pd(_mm_loadu_pd(consumeC + k), dt);
+        nCons = selectSse2(low, _mm_mul_pd(nCons, half), nCons);
+        cCons = selectSse2(low, _mm_mul_pd(cCons, half), cCons);
+        __m128d n = _mm_add_pd(_mm_loadu_pd(nitrogen + k), _mm_mul_pd(_mm_loadu_pd(regenN + k), dt));
+        __m128d c = _mm_add_pd(_mm_loadu_pd(carbon + k), _mm_mul_pd(_mm_loadu_pd(regenC + k), dt));
+        n = _mm_max_pd(_mm_min_pd(maxN, _mm_sub_pd(n, nCons)), zero);
+        c = _mm_max_pd(_mm_min_pd(maxC, _mm_sub_pd(c, cCons)), zero);
+        _mm_storeu_pd(nitrogen + k, n);
+        _mm_storeu_pd(carbon + k, c);
+    }
+    regenerateScalar(nitrogen, carbon, status, regenN, regenC, consumeN, consumeC, deltaTime, k, count);
+}
+
+// ---------- AVX2实现，每次4格 ----------
+
+NUTRIENT_TARGET_AVX2
+void consumeAvx2(double* nitrogen, double* carbon, quint8* status,
+                 const double* consumeN, const double* consumeC,
+                 double deltaTime, int count)
+{
+    const __m256d dt = _mm256_set1_pd(deltaTime);
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const __m256d n = _mm256_loadu_pd(nitrogen + k);
+        const __m256d c = _mm256_loadu_pd(carbon + k);
+        const __m256d nNeed = _mm256_mul_pd(_mm256_loadu_pd(consumeN + k), dt);
+        const __m256d cNeed = _mm256_mul_pd(_mm256_loadu_pd(consumeC + k), dt);
+        const __m256d enough = _mm256_and_pd(_mm256_cmp_pd(n, nNeed, _CMP_NLT_UQ),
+                                             _mm256_cmp_pd(c, cNeed, _CMP_NLT_UQ));
+        _mm256_storeu_pd(nitrogen + k, _mm256_blendv_pd(n, _mm256_sub_pd(n, nNeed), enough));
+        _mm256_storeu_pd(carbon + k, _mm256_blendv_pd(c, _mm256_sub_pd(c, cNeed), enough));
+        const int bits = _mm256_movemask_pd(enough);
+        for (int lane = 0; lane < 4; ++lane) {
+            status[k + lane] = (bits & (1 << lane)) ? CellState::NORMAL : CellState::RESOURCE_LOW;
+        }
+    }
+    _mm256_zeroupper(); // 清零YMM高位后再执行非VEX代码，避免AVX/SSE切换代价（GCC对target属性函数不会自动插入）
+    consumeScalar(nitrogen, carbon, status, consumeN, consumeC, deltaTime, k, count);
+}
+
+NUTRIENT_TARGET_AVX2
+void regenerateAvx2(double* nitrogen, double* carbon, const quint8* status,
+                    const double* regenN, const double* regenC,
+                    const double* consumeN, const double* consumeC,
+                    double deltaTime, int count)
+{
+    const __m256d dt = _mm256_set1_pd(deltaTime);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d maxN = _mm256_set1_pd(NutrientKernel::MAX_NITROGEN);
+    const __m256d maxC = _mm256_set1_pd(NutrientKernel::MAX_CARBON);
+    const __m256d resourceLow = _mm256_set1_pd(CellState::RESOURCE_LOW);
+    const __m256d lightLow = _mm256_set1_pd(CellState::LIGHT_LOW);
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        // 4个状态字节扩展为4个double后比较
+        int packed;
+        std::memcpy(&packed, status + k, sizeof(packed));
+        const __m256d s = _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+        const __m256d low = _mm256_or_pd(_mm256_cmp_pd(s, resourceLow, _CMP_EQ_OQ),
+                                         _mm256_cmp_pd(s, lightLow, _CMP_EQ_OQ));
+        __m256d nCons = _mm256_mul_pd(_mm256_loadu_pd(consumeN + k), dt);
+        __m256d cCons = _mm256_mul_pd(_mm256_loadu_pd(consumeC + k), dt);
+        nCons = _mm256_blendv_pd(nCons, _mm256_mul_pd(nCons, half), low);
+        cCons = _mm256_blendv_pd(cCons, _mm256_mul_pd(cCons, half), low);
+        __m256d n = _mm256_add_pd(_mm256_loadu_pd(nitrogen + k), _mm256_mul_pd(_mm256_loadu_pd(regenN + k), dt));
+        __m256d c = _mm256_add_pd(_mm256_loadu_pd(carbon + k), _mm256_mul_pd(_mm256_loadu_pd(regenC + k), dt));
+        n = _mm256_max_pd(_mm256_min_pd(maxN, _mm256_sub_pd(n, nCons)), zero);
+        c = _mm256_max_pd(_mm256_min_pd(maxC, _mm256_sub_pd(c, cCons)), zero);
+        _mm256_storeu_pd(nitrogen + k, n);
+        _mm256_storeu_pd(carbon + k, c);
+    }
+    _mm256_zeroupper();
+    regenerateScalar(nitrogen, carbon, status, regenN, regenC, consumeN, consumeC, deltaTime, k, count);
+}
+
+// CPU与操作系统是否都支持AVX2（操作系统需保存YMM寄存器）
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // NUTRIENT_KERNEL_X86
+
+NutrientKernel::Isa& currentIsa() {
+    static NutrientKernel::Isa isa = NutrientKernel::bestIsa();
+    return isa;
+}
+
+} // namespace
+
+NutrientKernel::Isa NutrientKernel::bestIsa() {
+#ifdef NUTRIENT_KERNEL_X86
+    static const Isa best = cpuHasAvx2() ? ISA_AVX2 : ISA_SSE2;
+    return best;
+#else
+    return ISA_SCALAR;
+#endif
+}
+
+NutrientKernel::Isa NutrientKernel::activeIsa() {
+    return currentIsa();
+}
+
+void NutrientKernel::setIsa(Isa isa) {
+    currentIsa() = isa <= bestIsa() ? isa : bestIsa();
+}
+
+const char* NutrientKernel::isaName(Isa isa) {
+    switch (isa) {
+    case ISA_AVX2: return "avx2";
+    case ISA_SSE2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+void NutrientKernel::consume(double* nitrogen, double* carbon, quint8* status,
+                             const double* consumeN, const double* consumeC,
+                             double deltaTime, int count)
+{
+    switch (currentIsa()) {
+#ifdef NUTRIENT_KERNEL_X86
+    case ISA_AVX2:
+        consumeAvx2(nitrogen, carbon, status, consumeN, consumeC, deltaTime, count);
+        break;
+    case ISA_SSE2:
+        consumeSse2(nitrogen, carbon, status, consumeN, consumeC, deltaTime, count);
+        break;
+#endif
+    default:
+        consumeScalar(nitrogen, carbon, status, consumeN, consumeC, deltaTime, 0, count);
+        break;
+    }
+}
+
+void NutrientKernel::regenerate(double* nitrogen, double* carbon, const quint8* status,
+                                const double* regenN, const double* regenC,
+                                const double* consumeN, const double* consumeC,
+                                double deltaTime, int count)
+{
+    switch (currentIsa()) {
+#ifdef NUTRIENT_KERNEL_X86
+    case ISA_AVX2:
+        regenerateAvx2(nitrogen, carbon, status, regenN, regenC, consumeN, consumeC, deltaTime, count);
+        break;
+    case ISA_SSE2:
+        regenerateSse2(nitrogen, carbon, status, regenN, regenC, consumeN, consumeC, deltaTime, count);
+        break;
+#endif
+    default:
+        regenerateScalar(nitrogen, carbon, status, regenN, regenC, consumeN, consumeC, deltaTime, 0, count);
+        break;
+    }
+}
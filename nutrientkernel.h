@@ -0,0 +1,36 @@
+#ifndef NUTRIENTKERNEL_H // 防止头文件重复包含
+#define NUTRIENTKERNEL_H
+
+#include <QtGlobal> // quint8
+
+// 氮碳资源的批量计算内核：对一段连续的double数组逐格计算。
+// 提供AVX2、SSE2和标量三种实现，首次调用时按CPU支持情况选用最快的一种；
+// 各实现的运算顺序与标量版完全相同，结果逐位一致，可随时切换。
+class NutrientKernel {
+public:
+    // 指令集实现
+    enum Isa { ISA_SCALAR, ISA_SSE2, ISA_AVX2 };
+
+    static constexpr double MAX_NITROGEN = 30.0; // 氮上限
+    static constexpr double MAX_CARBON = 80.0;   // 碳上限
+
+    static Isa bestIsa();            // 当前CPU支持的最快实现
+    static Isa activeIsa();          // 正在使用的实现
+    static void setIsa(Isa isa);     // 指定实现（基准测试/校验用），CPU不支持时退回bestIsa()；不要在计算过程中调用
+    static const char* isaName(Isa isa);
+
+    // 每帧消耗：需求为consume*deltaTime，氮碳都够时扣除并记为NORMAL，否则不扣除并记为RESOURCE_LOW
+    static void consume(double* nitrogen, double* carbon, quint8* status,
+                        const double* consumeN, const double* consumeC,
+                        double deltaTime, int count);
+
+    // 恢复、消耗与钳制一次完成（状态为RESOURCE_LOW/LIGHT_LOW时消耗减半）：
+    // value = max(0, min(上限, value + regen*deltaTime - consume*deltaTime))
+    // 注意：游戏的每步模拟不调用它（资源只由consume消耗，原版即如此），目前只有基准测试用到
+    static void regenerate(double* nitrogen, double* carbon, const quint8* status,
+                           const double* regenN, const double* regenC,
+                           const double* consumeN, const double* consumeC,
+                           double deltaTime, int count);
+};
+
+#endif // NUTRIENTKERNEL_H
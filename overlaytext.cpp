@@ -0,0 +1,88 @@
+#include "overlaytext.h" // 叠加文字头文件
+#include <QPainter>       // 绘图
+#include <QColor>
+#include <QRect>
+
+OverlayText* OverlayText::instance() {
+    static OverlayText overlay;
+    return &overlay;
+}
+
+OverlayText::OverlayText()
+{
+    auto pointFont = [](int pointSize, bool bold) {
+        QFont f;
+        f.setPointSize(pointSize);
+        f.setBold(bold);
+        return f;
+    };
+    m_fonts[STYLE_RESOURCE] = QFont("Arial", 8, QFont::Bold);
+    m_fonts[STYLE_LIGHT] = QFont("Arial", 10, QFont::Bold);
+    m_fonts[STYLE_GRID_LIGHT] = QFont("Arial", 11, QFont::Bold);
+    m_fonts[STYLE_CELL_INFO] = QFont("Arial", 8);
+    m_fonts[STYLE_LIGHT_BAR] = QFont("Arial", 7);
+    m_fonts[STYLE_STATUS] = pointFont(11, true);
+    m_fonts[STYLE_TAG] = QFont("Arial", 14, QFont::Bold);
+    m_fonts[STYLE_VALUE] = QFont();
+    m_fonts[STYLE_COORD] = pointFont(6, false);
+    m_fonts[STYLE_BADGE] = pointFont(14, true);
+    m_fonts[STYLE_BADGE_SMALL] = pointFont(12, true);
+}
+
+const QStaticText& OverlayText::layout(Style style, const QString& text)
+{
+    QHash<QString, QStaticText>& cache = m_cache[style];
+    auto it = cache.find(text);
+    if (it == cache.end()) {
+        if (cache.size() >= MAX_ENTRIES) {
+            cache.clear();
+        }
+        QStaticText staticText(text);
+        staticText.setTextFormat(Qt::PlainText);
+        staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+        staticText.prepare(QTransform(), m_fonts[style]);
+        it = cache.insert(text, staticText);
+    }
+    return it.value();
+}
+
+void OverlayText::draw(QPainter& painter, Style style, const QRect& rect, const QString& text,
+                       const QColor& color, Qt::Alignment alignment)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    const QStaticText& staticText = layout(style, text);
+    const QSizeF size = staticText.size();
+    qreal x = rect.left() + (rect.width() - size.width()) / 2;
+    if (alignment & Qt::AlignLeft) {
+        x = rect.left();
+    } else if (alignment & Qt::AlignRight) {
+        x = rect.left() + rect.width() - size.width();
+    }
+    qreal y = rect.top() + (rect.height() - size.height()) / 2;
+    if (alignment & Qt::AlignTop) {
+        y = rect.top();
+    } else if (alignment & Qt::AlignBottom) {
+        y = rect.top() + rect.height() - size.height();
+    }
+    painter.setFont(m_fonts[style]);
+    painter.setPen(color);
+    painter.drawStaticText(QPointF(x, y), staticText);
+}
+
+void OverlayText::clear()
+{
+    for (QHash<QString, QStaticText>& cache : m_cache) {
+        cache.clear();
+    }
+}
+
+int OverlayText::getCachedCount() const
+{
+    int count = 0;
+    for (const QHash<QString, QStaticText>& cache : m_cache) {
+        count += cache.size();
+    }
+    return count;
+}
@@ -0,0 +1,58 @@
+#ifndef OVERLAYTEXT_H // 防止头文件重复包含
+#define OVERLAYTEXT_H
+
+#include <QFont>       // 字体
+#include <QHash>       // 排版缓存
+#include <QStaticText> // 缓存排版的静态文本
+
+class QPainter;
+class QRect;
+class QColor;
+
+// 格子与网格上的叠加文字（资源数值、状态、特性角标）的绘制器单例
+//
+// 每种文字样式的字体只创建一次；每段文字第一次出现时排版为QStaticText并按内容缓存，
+// 之后绘制同样的数值只是几次字形贴图，不再解析HTML、不再新建QTextDocument或字体。
+// 资源与光照数值都是小整数，缓存的条目数很有限；单个样式超过MAX_ENTRIES时整体清空重来。
+// 只在界面线程使用。
+class OverlayText {
+public:
+    // 文字样式（字体）
+    enum Style {
+        STYLE_RESOURCE,     // 格子内N/C数值行（Arial 8 粗体）
+        STYLE_LIGHT,        // 格子内L数值行（Arial 10 粗体）
+        STYLE_GRID_LIGHT,   // 网格L数值行（Arial 11 粗体）
+        STYLE_CELL_INFO,    // 单元格下方资源标注（Arial 8）
+        STYLE_LIGHT_BAR,    // 光照条文字（Arial 7）
+        STYLE_STATUS,       // 格子顶部状态（11号粗体）
+        STYLE_TAG,          // 可否种植标签（Arial 14 粗体）
+        STYLE_VALUE,        // 图标旁的数值（默认字体）
+        STYLE_COORD,        // 左上角坐标（6号）
+        STYLE_BADGE,        // 特性角标（14号粗体）
+        STYLE_BADGE_SMALL,  // 两个字符的特性角标（12号粗体）
+        STYLE_COUNT
+    };
+
+    static const int MAX_ENTRIES = 4096; // 单个样式最多缓存的文字段数
+
+    static OverlayText* instance(); // 获取单例实例
+
+    const QFont& font(Style style) const { return m_fonts[style]; }
+
+    // 在rect内按对齐方式绘制一段文字（只支持单行纯文本）
+    void draw(QPainter& painter, Style style, const QRect& rect, const QString& text,
+              const QColor& color, Qt::Alignment alignment = Qt::AlignCenter);
+
+    void clear();
+    int getCachedCount() const; // 所有样式缓存的文字段数
+
+private:
+    OverlayText();
+
+    QFont m_fonts[STYLE_COUNT];
+    QHash<QString, QStaticText> m_cache[STYLE_COUNT];
+
+    const QStaticText& layout(Style style, const QString& text); // 取已排版的文字，没有时排版并缓存
+};
+
+#endif // OVERLAYTEXT_H
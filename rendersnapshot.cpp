@@ -0,0 +1,88 @@
+#include "rendersnapshot.h" // 渲染快照头文件
+#include "algaegame.h"      // 选中的藻类与资源
+#include "gameresources.h"
+#include "gridmodel.h"
+
+RenderSnapshot::RenderSnapshot()
+    : m_selType(AlgaeType::NONE)
+    , m_resources{ 0.0, 0.0, 0.0, 0.0 }
+    , m_affordable(0)
+    , m_captureCount(0)
+{
+}
+
+void RenderSnapshot::clear()
+{
+    m_area = QRect();
+    m_species.clear();
+    m_status.clear();
+    m_traits.clear();
+    m_shaded.clear();
+    m_plantable.clear();
+    m_light.clear();
+    m_nitrogen.clear();
+    m_carbon.clear();
+}
+
+void RenderSnapshot::capture(const AlgaeGame& game, const QRect& cells)
+{
+    ++m_captureCount;
+    const GridModel* grid = game.getGrid();
+    const GameResources* res = game.getResources();
+    m_selType = game.getSelectedAlgaeType();
+    m_resources[0] = res->getCarbohydrates();
+    m_resources[1] = res->getLipids();
+    m_resources[2] = res->getProteins();
+    m_resources[3] = res->getVitamins();
+    m_affordable = 0;
+    for (int t = AlgaeType::TYPE_A; t < AlgaeType::TYPE_COUNT; ++t) {
+        if (AlgaeType::canAfford(static_cast<AlgaeType::Type>(t), m_resources[0], m_resources[1], m_resources[2], m_resources[3])) {
+            m_affordable |= 1u << t;
+        }
+    }
+
+    m_area = cells.intersected(QRect(0, 0, grid->getCols(), grid->getRows()));
+    const size_t count = m_area.isEmpty() ? 0 : static_cast<size_t>(m_area.width()) * m_area.height();
+    m_species.resize(count);
+    m_status.resize(count);
+    m_traits.resize(count);
+    m_shaded.resize(count);
+    m_plantable.resize(count);
+    m_light.resize(count);
+    m_nitrogen.resize(count);
+    m_carbon.resize(count);
+    if (count == 0) return;
+
+    // 每种藻类的种植光照要求，逐格比较得到可种植掩码
+    int lightRequired[AlgaeType::TYPE_COUNT] = {};
+    for (int t = AlgaeType::TYPE_A; t < AlgaeType::TYPE_COUNT; ++t) {
+        lightRequired[t] = AlgaeType::getProperties(static_cast<AlgaeType::Type>(t)).lightRequiredPlant;
+    }
+
+    // 遮荫按列自上而下扫描：shade为当前行仍处在上方藻类遮光深度内的剩余行数，
+    // 从范围上方getMaxShadingDepth()行开始扫，范围外的藻类投下的遮荫也能算到
+    const int scanTop = qMax(0, m_area.top() - AlgaeType::getMaxShadingDepth());
+    for (int col = m_area.left(); col <= m_area.right(); ++col) {
+        int shade = 0;
+        for (int row = scanTop; row <= m_area.bottom(); ++row) {
+            const AlgaeType::Type type = grid->getTypeAt(row, col);
+            if (row >= m_area.top()) {
+                const int i = index(row, col);
+                const double light = grid->getLightAt(row, col);
+                quint8 plantable = 0;
+                for (int t = AlgaeType::TYPE_A; t < AlgaeType::TYPE_COUNT; ++t) {
+                    if (light >= lightRequired[t]) plantable |= 1u << t;
+                }
+                m_species[i] = static_cast<quint8>(type);
+                m_status[i] = static_cast<quint8>(grid->getStatusAt(row, col));
+                m_traits[i] = grid->getTraitsAt(row, col);
+                m_shaded[i] = shade > 0 ? 1 : 0;
+                m_plantable[i] = plantable;
+                m_light[i] = static_cast<float>(light);
+                m_nitrogen[i] = static_cast<float>(grid->getNitrogenAt(row, col));
+                m_carbon[i] = static_cast<float>(grid->getCarbonAt(row, col));
+            }
+            shade = qMax(shade - 1, type == AlgaeType::NONE ? 0 : AlgaeType::getProperties(type).shadingDepth);
+        }
+    }
+}
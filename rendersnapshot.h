@@ -0,0 +1,63 @@
+#ifndef RENDERSNAPSHOT_H // 防止头文件重复包含
+#define RENDERSNAPSHOT_H
+
+#include <QRect>   // 快照覆盖的格子范围
+#include <vector>
+#include "algaetype.h" // 藻类类型定义
+
+class AlgaeGame;
+
+// 一帧的渲染快照：界面绘制与悬浮提示需要的全部数据，每帧从模型取一次（只依赖QtCore）
+//
+// 只覆盖调用方给出的格子范围（通常是滚动区域中可见的格子），每个字段一个紧凑数组：
+// 藻类、状态、特性标记位、遮荫标记、光照/氮/碳，以及每格的可种植掩码（第t位表示光照满足t型的种植要求）。
+// 另记选中的藻类、资源总量与可负担掩码（第t位表示资源够种t型）。
+// capture之后只读，绘制时不再调用模型，也不用沿控件树向上查找主窗口。
+class RenderSnapshot {
+public:
+    RenderSnapshot();
+
+    // 从游戏当前状态取出cells范围（x为列，y为行，超出网格的部分被裁掉）的快照
+    void capture(const AlgaeGame& game, const QRect& cells);
+    void clear(); // 清空，不覆盖任何格子
+
+    const QRect& getArea() const { return m_area; } // 覆盖的格子范围（x为列，y为行）
+    bool contains(int row, int col) const { return m_area.contains(col, row); }
+    bool covers(const QRect& cells) const { return cells.isEmpty() || m_area.contains(cells); }
+
+    AlgaeType::Type getSelectedType() const { return m_selType; }
+    double getResource(int i) const { return m_resources[i]; } // 0糖、1脂质、2蛋白质、3维生素
+    bool canAfford(AlgaeType::Type type) const { return m_affordable & (1u << type); }
+    quint64 getCaptureCount() const { return m_captureCount; } // 累计capture次数
+
+    // 单格数据（调用方保证contains(row, col)）
+    AlgaeType::Type typeAt(int row, int col) const { return static_cast<AlgaeType::Type>(m_species[index(row, col)]); }
+    int statusAt(int row, int col) const { return m_status[index(row, col)]; }     // CellState::Status
+    quint8 traitsAt(int row, int col) const { return m_traits[index(row, col)]; }  // GridModel::TraitFlag
+    bool isShaded(int row, int col) const { return m_shaded[index(row, col)]; }    // 上方已种藻类的遮荫范围内
+    float lightAt(int row, int col) const { return m_light[index(row, col)]; }
+    float nitrogenAt(int row, int col) const { return m_nitrogen[index(row, col)]; }
+    float carbonAt(int row, int col) const { return m_carbon[index(row, col)]; }
+    bool lightEnough(int row, int col, AlgaeType::Type type) const { return m_plantable[index(row, col)] & (1u << type); }
+
+private:
+    QRect m_area;
+    AlgaeType::Type m_selType;
+    double m_resources[4];
+    quint8 m_affordable; // 可负担掩码
+    quint64 m_captureCount;
+
+    // 单格字段，下标为index(row, col)，行优先
+    std::vector<quint8> m_species;
+    std::vector<quint8> m_status;
+    std::vector<quint8> m_traits;
+    std::vector<quint8> m_shaded;
+    std::vector<quint8> m_plantable; // 可种植掩码
+    std::vector<float> m_light;
+    std::vector<float> m_nitrogen;
+    std::vector<float> m_carbon;
+
+    int index(int row, int col) const { return (row - m_area.top()) * m_area.width() + (col - m_area.left()); }
+};
+
+#endif // RENDERSNAPSHOT_H
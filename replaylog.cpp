@@ -0,0 +1,337 @@
+#include "replaylog.h"  // 操作录像头文件
+#include <QFile>        // 文件读写
+#include <QSaveFile>    // 写完才替换原文件
+#include <QtEndian>     // 小端序读写
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char MAGIC[8] = { 'A', 'L', 'G', 'A', 'E', 'R', 'E', 'P' };
+
+// 文件头各字段的偏移
+enum HeaderOffset {
+    OFF_MAGIC = 0,           // char[8]
+    OFF_VERSION = 8,         // quint32
+    OFF_FLAGS = 12,          // quint32，FLAG_*
+    OFF_SEED = 16,           // quint32，第一个关键帧的资源随机种子（便于查看，回放以关键帧为准）
+    OFF_END_TICK = 24,       // qint64
+    OFF_INPUT_COUNT = 32,    // qint64
+    OFF_EVENT_BYTES = 40,    // quint64
+    OFF_KEYFRAME_COUNT = 48, // quint32
+    HEADER_SIZE = 56
+};
+
+// 每个关键帧的定长信息
+enum KeyframeOffset {
+    KF_TICK = 0,       // qint64
+    KF_OFFSET = 8,     // qint64，在操作流中的位置（差值编码的基准读档时顺序解码得到）
+    KF_FLAGS = 16,     // quint32，KF_FLAG_*
+    KF_SAVE_SIZE = 24, // quint64，之后紧接的存档字节数
+    KF_SIZE = 32
+};
+
+const quint32 FLAG_RESOURCE_SEED = 1u << 0; // 第一个关键帧使用固定的资源随机种子
+const quint32 KF_FLAG_RESTORE = 1u << 0;    // 回放经过时必须恢复
+
+void writeVarint(QByteArray& out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+// 读取一个变长整数，越界或超过10字节时返回false
+bool readVarint(const QByteArray& in, qint64& offset, quint64& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= in.size()) {
+            return false;
+        }
+        const uchar byte = static_cast<uchar>(in.at(offset++));
+        value |= quint64(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 有符号差值映射为无符号（0,-1,1,-2...→0,1,2,3...），小的负数也只占一个字节
+quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+bool fail(QString* error, const QString& message)
+{
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+} // namespace
+
+void ReplayLog::clear()
+{
+    m_events.clear();
+    m_last = Cursor();
+    m_inputCount = 0;
+    m_endTick = 0;
+    m_keyframes.clear();
+}
+
+void ReplayLog::appendInput(qint64 tick, Input input, int row, int col, bool result, AlgaeType::Type type)
+{
+    Q_ASSERT(tick >= m_last.tick);
+    writeVarint(m_events, (quint64(qMax<qint64>(0, tick - m_last.tick)) << 3) | (result ? 4u : 0u) | input);
+    if (input == INPUT_SELECT) {
+        writeVarint(m_events, static_cast<quint64>(type));
+    } else {
+        writeVarint(m_events, zigzag(qint64(row) - m_last.row));
+        writeVarint(m_events, zigzag(qint64(col) - m_last.col));
+        m_last.row = row;
+        m_last.col = col;
+    }
+    m_last.tick = qMax(m_last.tick, tick);
+    m_last.offset = m_events.size();
+    ++m_inputCount;
+    m_endTick = qMax(m_endTick, m_last.tick);
+}
+
+void ReplayLog::appendKeyframe(qint64 tick, bool restore, SaveGame save)
+{
+    Q_ASSERT(tick >= m_last.tick);
+    Keyframe keyframe;
+    keyframe.tick = tick;
+    keyframe.cursor = m_last;
+    keyframe.restore = restore;
+    keyframe.save = std::move(save);
+    m_keyframes.push_back(std::move(keyframe));
+    m_endTick = qMax(m_endTick, tick);
+}
+
+int ReplayLog::thinKeyframes()
+{
+    int removed = 0;
+    bool drop = false;
+    auto keep = m_keyframes.begin();
+    for (auto it = m_keyframes.begin(); it != m_keyframes.end(); ++it) {
+        if (it != m_keyframes.begin() && !it->restore) {
+            drop = !drop;
+            if (drop) {
+                ++removed;
+                continue;
+            }
+        }
+        if (keep != it) {
+            *keep = std::move(*it);
+        }
+        ++keep;
+    }
+    m_keyframes.erase(keep, m_keyframes.end());
+    return removed;
+}
+
+bool ReplayLog::next(Cursor& cursor, Event& event) const
+{
+    qint64 offset = cursor.offset;
+    quint64 header = 0;
+    if (!readVarint(m_events, offset, header) || (header & 3) > INPUT_REMOVE) {
+        return false;
+    }
+    event.input = static_cast<Input>(header & 3);
+    event.result = header & 4;
+    event.tick = cursor.tick + qint64(header >> 3);
+    if (event.input == INPUT_SELECT) {
+        quint64 type = 0;
+        if (!readVarint(m_events, offset, type) || type >= quint64(AlgaeType::TYPE_COUNT)) {
+            return false;
+        }
+        event.type = static_cast<AlgaeType::Type>(type);
+        event.row = cursor.row;
+        event.col = cursor.col;
+    } else {
+        quint64 dRow = 0, dCol = 0;
+        if (!readVarint(m_events, offset, dRow) || !readVarint(m_events, offset, dCol)) {
+            return false;
+        }
+        event.row = static_cast<int>(cursor.row + unzigzag(dRow));
+        event.col = static_cast<int>(cursor.col + unzigzag(dCol));
+        event.type = AlgaeType::NONE;
+        cursor.row = event.row;
+        cursor.col = event.col;
+    }
+    cursor.offset = offset;
+    cursor.tick = event.tick;
+    return true;
+}
+
+int ReplayLog::keyframeBefore(qint64 tick) const
+{
+    const auto it = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), tick,
+                                     [](qint64 t, const Keyframe& keyframe) { return t < keyframe.tick; });
+    return static_cast<int>(it - m_keyframes.begin()) - 1;
+}
+
+qint64 ReplayLog::getKeyframeBytes() const
+{
+    qint64 bytes = 0;
+    for (const Keyframe& keyframe : m_keyframes) {
+        bytes += SaveGame::fileSize(keyframe.save.grid.rows, keyframe.save.grid.cols);
+    }
+    return bytes;
+}
+
+bool ReplayLog::save(const QString& path, QString* error) const
+{
+    QByteArray header(HEADER_SIZE, '\0');
+    char* h = header.data();
+    std::memcpy(h + OFF_MAGIC, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint32>(VERSION, h + OFF_VERSION);
+    if (!m_keyframes.empty()) {
+        const GridModel::State& first = m_keyframes.front().save.grid;
+        qToLittleEndian<quint32>(first.hasResourceSeed ? FLAG_RESOURCE_SEED : 0u, h + OFF_FLAGS);
+        qToLittleEndian<quint32>(first.resourceSeed, h + OFF_SEED);
+    }
+    qToLittleEndian<qint64>(m_endTick, h + OFF_END_TICK);
+    qToLittleEndian<qint64>(m_inputCount, h + OFF_INPUT_COUNT);
+    qToLittleEndian<quint64>(m_events.size(), h + OFF_EVENT_BYTES);
+    qToLittleEndian<quint32>(static_cast<quint32>(m_keyframes.size()), h + OFF_KEYFRAME_COUNT);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(header) != header.size() ||
+        file.write(m_events) != m_events.size()) {
+        return fail(error, file.errorString());
+    }
+    // 关键帧逐个序列化写出，不把整个文件拼在内存里
+    for (const Keyframe& keyframe : m_keyframes) {
+        const QByteArray save = keyframe.save.serialize();
+        QByteArray info(KF_SIZE, '\0');
+        char* k = info.data();
+        qToLittleEndian<qint64>(keyframe.tick, k + KF_TICK);
+        qToLittleEndian<qint64>(keyframe.cursor.offset, k + KF_OFFSET);
+        qToLittleEndian<quint32>(keyframe.restore ? KF_FLAG_RESTORE : 0u, k + KF_FLAGS);
+        qToLittleEndian<quint64>(save.size(), k + KF_SAVE_SIZE);
+        if (file.write(info) != info.size() || file.write(save) != save.size()) {
+            return fail(error, file.errorString());
+        }
+    }
+    if (!file.commit()) {
+        return fail(error, file.errorString());
+    }
+    return true;
+}
+
+// 整个文件映射到内存后解析；操作流整体解码一遍校验，关键帧逐个按存档格式校验
+bool ReplayLog::load(const QString& path, QString* error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(error, file.errorString());
+    }
+    const qint64 size = file.size();
+    QByteArray bytes;
+    const char* data = nullptr;
+    uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    if (mapped) {
+        data = reinterpret_cast<const char*>(mapped);
+    } else {
+        bytes = file.readAll();
+        data = bytes.constData();
+    }
+    struct Unmap {
+        QFile& file;
+        uchar* mapped;
+        ~Unmap() { if (mapped) file.unmap(mapped); }
+    } unmap{ file, mapped };
+
+    if (size < HEADER_SIZE || std::memcmp(data + OFF_MAGIC, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail(error, "不是操作录像文件");
+    }
+    const quint32 version = qFromLittleEndian<quint32>(data + OFF_VERSION);
+    if (version != VERSION) {
+        return fail(error, QString("不支持的录像版本%1").arg(version));
+    }
+    const qint64 endTick = qFromLittleEndian<qint64>(data + OFF_END_TICK);
+    const qint64 inputCount = qFromLittleEndian<qint64>(data + OFF_INPUT_COUNT);
+    const quint64 eventBytes = qFromLittleEndian<quint64>(data + OFF_EVENT_BYTES);
+    const quint32 keyframeCount = qFromLittleEndian<quint32>(data + OFF_KEYFRAME_COUNT);
+    if (eventBytes > quint64(size - HEADER_SIZE)) {
+        return fail(error, "录像长度与文件头不符（文件可能被截断）");
+    }
+
+    ReplayLog log;
+    log.m_events = QByteArray(data + HEADER_SIZE, static_cast<qsizetype>(eventBytes));
+    log.m_endTick = endTick;
+    Cursor cursor;
+    Event event;
+    while (cursor.offset < log.m_events.size()) {
+        if (!log.next(cursor, event)) {
+            return fail(error, QString("操作流在第%1字节处无效").arg(cursor.offset));
+        }
+        ++log.m_inputCount;
+    }
+    if (log.m_inputCount != inputCount || cursor.tick > endTick) {
+        return fail(error, "操作流与文件头不符");
+    }
+    log.m_last = cursor;
+
+    qint64 offset = HEADER_SIZE + qint64(eventBytes);
+    for (quint32 i = 0; i < keyframeCount; ++i) {
+        if (size - offset < KF_SIZE) {
+            return fail(error, "录像长度与文件头不符（文件可能被截断）");
+        }
+        const char* k = data + offset;
+        Keyframe keyframe;
+        keyframe.tick = qFromLittleEndian<qint64>(k + KF_TICK);
+        keyframe.cursor.offset = qFromLittleEndian<qint64>(k + KF_OFFSET);
+        keyframe.restore = qFromLittleEndian<quint32>(k + KF_FLAGS) & KF_FLAG_RESTORE;
+        const quint64 saveSize = qFromLittleEndian<quint64>(k + KF_SAVE_SIZE);
+        offset += KF_SIZE;
+        if (saveSize > quint64(size - offset)) {
+            return fail(error, "录像长度与文件头不符（文件可能被截断）");
+        }
+        const Keyframe* previous = log.m_keyframes.empty() ? nullptr : &log.m_keyframes.back();
+        if (keyframe.cursor.offset < 0 || keyframe.cursor.offset > log.m_events.size() ||
+            keyframe.tick > endTick ||
+            (previous && (keyframe.tick < previous->tick || keyframe.cursor.offset < previous->cursor.offset)) ||
+            (!previous && (keyframe.tick != 0 || keyframe.cursor.offset != 0))) {
+            return fail(error, QString("第%1个关键帧的位置无效").arg(i + 1));
+        }
+        QString saveError;
+        if (!keyframe.save.deserialize(data + offset, qint64(saveSize), &saveError)) {
+            return fail(error, QString("第%1个关键帧：%2").arg(i + 1).arg(saveError));
+        }
+        offset += qint64(saveSize);
+        log.m_keyframes.push_back(std::move(keyframe));
+    }
+    if (log.m_keyframes.empty()) {
+        return fail(error, "录像没有初始关键帧");
+    }
+    if (offset != size) {
+        return fail(error, "录像长度与文件头不符");
+    }
+    // 顺序解码一遍，得到每个关键帧处的解码基准；关键帧必须落在两条操作之间，且不早于之前的操作
+    Cursor scan;
+    for (Keyframe& keyframe : log.m_keyframes) {
+        while (scan.offset < keyframe.cursor.offset) {
+            log.next(scan, event);
+        }
+        if (scan.offset != keyframe.cursor.offset || scan.tick > keyframe.tick) {
+            return fail(error, "关键帧与操作流不符");
+        }
+        keyframe.cursor = scan;
+    }
+    *this = std::move(log);
+    return true;
+}
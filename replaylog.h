@@ -0,0 +1,93 @@
+#ifndef REPLAYLOG_H // 防止头文件重复包含
+#define REPLAYLOG_H
+
+#include <QByteArray> // 变长编码的操作流
+#include <QString>    // Qt字符串类
+#include <vector>
+#include "algaetype.h" // 藻类类型定义
+#include "savegame.h"  // 关键帧存档
+
+// 操作录像：玩家操作（选择藻类、种植、移除）连同发生时的模拟步号与结果，加上若干关键帧（只依赖QtCore）
+//
+// 模拟按固定步长推进且与帧率、线程数无关，所以同样的初始状态加同样的操作序列会得到逐位相同的结果；
+// 录像只需记下操作，回放时从关键帧恢复再按步号重放操作即可。
+//
+// 操作流为变长整数（LEB128）编码，每条操作：
+//   头     (步号与上一条操作之差 << 3) | (是否生效 << 2) | 操作类型
+//   种植/移除  行、列与上一条操作的差值（zigzag编码）
+//   选择   藻类类型
+// 没有生效的种植/移除也记下（光照略低时种植返回失败但格子已种下），回放时比较结果即可发现分叉。
+// 玩家的操作多在相邻格子、间隔几十步，一条种植通常只占3字节。
+//
+// 关键帧记录所在的步号、在操作流中的位置（之前的操作已生效）与完整存档：
+//   restore  重置、改变尺寸、读档、应用布局等不经过操作流的改动之后记下，回放经过时必须恢复
+//   其余     定期记下，只用于跳转（从不晚于目标的最近一个关键帧恢复再向前模拟）与一致性校验
+// 关键帧不改变操作流的编码（差值基准在读档时顺序解码得到），定期关键帧可以随时抽稀。
+//
+// 文件格式（小端序，版本VERSION）：魔数"ALGAEREP"、版本、资源随机种子标记与种子、结束步号、
+// 操作条数、操作流字节数、关键帧个数，之后是操作流，再之后逐个关键帧（定长信息 + 存档长度 + SaveGame::serialize）。
+class ReplayLog {
+public:
+    static const quint32 VERSION = 1; // 格式版本，不兼容的改动时递增
+
+    enum Input { INPUT_SELECT = 0, INPUT_PLANT = 1, INPUT_REMOVE = 2 };
+
+    // 操作流的解码位置：字节偏移加上差值编码的基准（上一条操作的步号与格子）
+    struct Cursor {
+        qint64 offset = 0;
+        qint64 tick = 0;
+        int row = 0;
+        int col = 0;
+    };
+
+    // 解码出的一条操作
+    struct Event {
+        qint64 tick = 0;
+        Input input = INPUT_SELECT;
+        int row = 0;                             // 种植/移除的格子
+        int col = 0;
+        AlgaeType::Type type = AlgaeType::NONE;  // 选择的藻类
+        bool result = true;                      // 录制时调用的返回值
+    };
+
+    struct Keyframe {
+        qint64 tick = 0;      // 所在步号
+        Cursor cursor;        // 之后的操作从这里开始解码
+        bool restore = false; // 回放经过时是否必须恢复（状态有操作流之外的改动）
+        SaveGame save;
+    };
+
+    void clear();
+
+    // 录制：步号不能早于上一条操作或关键帧
+    void appendInput(qint64 tick, Input input, int row, int col, bool result = true,
+                     AlgaeType::Type type = AlgaeType::NONE);
+    void appendKeyframe(qint64 tick, bool restore, SaveGame save);
+    void setEndTick(qint64 tick) { m_endTick = tick; }
+    // 定期关键帧每隔一个删掉一个（restore关键帧全部保留），返回删掉的个数
+    int thinKeyframes();
+
+    // 解码cursor处的下一条操作并前移cursor，到达操作流末尾或数据无效时返回false
+    bool next(Cursor& cursor, Event& event) const;
+    // 最后一个步号不晚于tick的关键帧下标（第一个关键帧总在步号0）
+    int keyframeBefore(qint64 tick) const;
+
+    qint64 getEndTick() const { return m_endTick; }
+    qint64 getInputCount() const { return m_inputCount; }
+    const QByteArray& getEvents() const { return m_events; }
+    const std::vector<Keyframe>& getKeyframes() const { return m_keyframes; }
+    qint64 getKeyframeBytes() const; // 关键帧存档的总字节数
+
+    // 读写录像文件，失败时返回false并在error中给出原因
+    bool save(const QString& path, QString* error = nullptr) const;
+    bool load(const QString& path, QString* error = nullptr);
+
+private:
+    QByteArray m_events;              // 变长编码的操作流
+    Cursor m_last;                    // 录制时操作流末尾的编码基准
+    qint64 m_inputCount = 0;
+    qint64 m_endTick = 0;             // 录制结束时的步号
+    std::vector<Keyframe> m_keyframes; // 按步号排列
+};
+
+#endif // REPLAYLOG_H
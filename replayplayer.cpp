@@ -0,0 +1,110 @@
+#include "replayplayer.h" // 录像回放头文件
+#include "algaegame.h"    // 游戏主逻辑
+
+ReplayPlayer::ReplayPlayer(const ReplayLog& log, AlgaeGame& game)
+    : m_log(log)
+    , m_game(game)
+{
+    if (!m_log.getKeyframes().empty()) {
+        restore(0);
+    }
+}
+
+bool ReplayPlayer::seek(qint64 tick)
+{
+    tick = qMax<qint64>(0, tick);
+    const int keyframe = m_log.keyframeBefore(tick);
+    if (keyframe < 0) {
+        return false;
+    }
+    // 目标在前方且最近的关键帧已经经过：直接向前比恢复关键帧更快
+    if (tick < m_tick || keyframe >= m_nextKeyframe) {
+        if (!restore(keyframe)) {
+            return false;
+        }
+    }
+    advanceTo(tick);
+    return true;
+}
+
+void ReplayPlayer::advanceTo(qint64 tick)
+{
+    const std::vector<ReplayLog::Keyframe>& keyframes = m_log.getKeyframes();
+    for (;;) {
+        // 关键帧记在它之后的操作之前
+        if (m_nextKeyframe < static_cast<int>(keyframes.size()) &&
+            keyframes[m_nextKeyframe].cursor.offset == m_cursor.offset) {
+            const ReplayLog::Keyframe& keyframe = keyframes[m_nextKeyframe];
+            if (keyframe.tick > tick) {
+                break;
+            }
+            simulateTo(keyframe.tick);
+            if (keyframe.restore) {
+                if (!restore(m_nextKeyframe)) {
+                    ++m_nextKeyframe; // 存档已在读录像时校验过，这里不会失败
+                }
+            } else {
+                if (m_verify) {
+                    ++m_verifiedCount;
+                    if (SaveGame::fromGame(m_game).serialize() != keyframe.save.serialize()) {
+                        ++m_mismatchCount;
+                    }
+                }
+                ++m_nextKeyframe;
+            }
+            continue;
+        }
+        ReplayLog::Cursor cursor = m_cursor;
+        ReplayLog::Event event;
+        if (!m_log.next(cursor, event) || event.tick > tick) {
+            break;
+        }
+        simulateTo(event.tick);
+        apply(event);
+        m_cursor = cursor;
+    }
+    simulateTo(tick);
+}
+
+bool ReplayPlayer::restore(int keyframe)
+{
+    const ReplayLog::Keyframe& frame = m_log.getKeyframes()[keyframe];
+    if (!m_game.loadSave(frame.save)) {
+        return false;
+    }
+    m_game.startGame(); // 种植/移除只在运行状态下生效
+    m_tick = frame.tick;
+    m_cursor = frame.cursor;
+    m_nextKeyframe = keyframe + 1;
+    ++m_restoreCount;
+    return true;
+}
+
+void ReplayPlayer::simulateTo(qint64 tick)
+{
+    while (m_tick < tick) {
+        const int steps = static_cast<int>(qMin<qint64>(tick - m_tick, SIM_CHUNK));
+        m_game.advance(steps);
+        m_tick += steps;
+    }
+}
+
+void ReplayPlayer::apply(const ReplayLog::Event& event)
+{
+    bool result = true;
+    switch (event.input) {
+    case ReplayLog::INPUT_SELECT:
+        m_game.setSelectedAlgaeType(event.type);
+        break;
+    case ReplayLog::INPUT_PLANT:
+        result = m_game.plantAlgae(event.row, event.col);
+        break;
+    case ReplayLog::INPUT_REMOVE:
+        result = m_game.removeAlgae(event.row, event.col);
+        break;
+    }
+    ++m_appliedCount;
+    if (result != event.result) {
+        ++m_divergedCount;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef REPLAYPLAYER_H // 防止头文件重复包含
+#define REPLAYPLAYER_H
+
+#include "replaylog.h" // 操作录像
+
+class AlgaeGame;
+
+// 录像回放：在给定的游戏上从初始关键帧开始，按步号重放录下的操作（只依赖QtCore）
+//
+// 不看真实时间，直接用AlgaeGame::advance推进，无界面时以最快速度运行。
+// 跳转（seek）从不晚于目标的最近一个关键帧恢复再向前模拟；目标就在当前位置之后、
+// 中间没有关键帧时直接向前模拟。经过restore关键帧时恢复它（录制时状态在那里被整体替换过）。
+// 打开校验时，经过定期关键帧会把游戏状态与关键帧逐字节比较，不一致说明回放与录制时分叉了。
+// 回放用的游戏不要挂录制器；回放期间游戏保持运行状态（没有事件循环时定时器不会触发）。
+class ReplayPlayer {
+public:
+    ReplayPlayer(const ReplayLog& log, AlgaeGame& game); // 恢复初始关键帧
+
+    void setVerify(bool verify) { m_verify = verify; }
+
+    bool seek(qint64 tick);      // 跳转到tick（可前可后），关键帧无法恢复时返回false
+    void advanceTo(qint64 tick); // 向前回放到tick，早于当前位置时不做任何事
+    void playToEnd() { advanceTo(m_log.getEndTick()); }
+
+    qint64 getTick() const { return m_tick; }   // 当前录像步号
+    bool atEnd() const { return m_tick >= m_log.getEndTick(); }
+
+    int getAppliedCount() const { return m_appliedCount; }   // 重放的操作数
+    int getDivergedCount() const { return m_divergedCount; } // 重放结果与录制时不同的种植/移除
+    int getRestoreCount() const { return m_restoreCount; }   // 恢复关键帧的次数
+    int getVerifiedCount() const { return m_verifiedCount; } // 校验过的关键帧数
+    int getMismatchCount() const { return m_mismatchCount; } // 校验不一致的关键帧数
+
+private:
+    const ReplayLog& m_log;
+    AlgaeGame& m_game;
+    ReplayLog::Cursor m_cursor; // 下一条操作的解码位置
+    int m_nextKeyframe = 0;     // 下一个要经过的关键帧
+    qint64 m_tick = 0;
+    bool m_verify = false;
+    int m_appliedCount = 0;
+    int m_divergedCount = 0;
+    int m_restoreCount = 0;
+    int m_verifiedCount = 0;
+    int m_mismatchCount = 0;
+
+    static const int SIM_CHUNK = 4096; // 每次advance的最大步数（帧末通知按块发出）
+
+    bool restore(int keyframe);
+    void simulateTo(qint64 tick);
+    void apply(const ReplayLog::Event& event);
+};
+
+#endif // REPLAYPLAYER_H
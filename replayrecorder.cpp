@@ -0,0 +1,61 @@
+#include "replayrecorder.h" // 操作录制器头文件
+#include "algaegame.h"      // 游戏主逻辑
+
+ReplayRecorder::ReplayRecorder(int keyframeInterval, qint64 keyframeBudget)
+    : m_initialInterval(qMax(1, keyframeInterval))
+    , m_interval(m_initialInterval)
+    , m_budget(keyframeBudget)
+{
+}
+
+void ReplayRecorder::start(const AlgaeGame& game)
+{
+    m_log.clear();
+    m_tick = 0;
+    m_lastSteps = game.getSimStepCount();
+    m_interval = m_initialInterval;
+    m_log.appendKeyframe(0, true, SaveGame::fromGame(game));
+    m_nextKeyframe = m_interval;
+}
+
+void ReplayRecorder::recordInput(const AlgaeGame& game, ReplayLog::Input input, int row, int col, bool result,
+                                 AlgaeType::Type type)
+{
+    sync(game);
+    m_log.appendInput(m_tick, input, row, col, result, type);
+}
+
+void ReplayRecorder::recordFrame(const AlgaeGame& game)
+{
+    sync(game);
+    if (m_tick < m_nextKeyframe) {
+        return;
+    }
+    m_log.appendKeyframe(m_tick, false, SaveGame::fromGame(game));
+    if (m_log.getKeyframeBytes() > m_budget && m_log.thinKeyframes() > 0) {
+        m_interval *= 2;
+    }
+    m_nextKeyframe = m_tick + m_interval;
+}
+
+void ReplayRecorder::sync(const AlgaeGame& game)
+{
+    const qint64 steps = game.getSimStepCount();
+    m_tick += qMax<qint64>(0, steps - m_lastSteps);
+    m_lastSteps = steps;
+    m_log.setEndTick(m_tick);
+}
+
+void ReplayRecorder::recordRestore(const AlgaeGame& game)
+{
+    // 步号在替换之前已经同步；替换后游戏的步数可能被重置，从这里重新计起
+    m_lastSteps = game.getSimStepCount();
+    m_log.appendKeyframe(m_tick, true, SaveGame::fromGame(game));
+    m_nextKeyframe = m_tick + m_interval;
+}
+
+bool ReplayRecorder::save(const AlgaeGame& game, const QString& path, QString* error)
+{
+    sync(game);
+    return m_log.save(path, error);
+}
@@ -0,0 +1,50 @@
+#ifndef REPLAYRECORDER_H // 防止头文件重复包含
+#define REPLAYRECORDER_H
+
+#include <QString>      // Qt字符串类
+#include "replaylog.h"  // 操作录像
+
+class AlgaeGame;
+
+// 操作录制器：挂到AlgaeGame上（AlgaeGame::setRecorder）后，游戏在玩家操作、每帧模拟结束
+// 和状态被整体替换时调用它，把操作和关键帧写进ReplayLog（只依赖QtCore）
+//
+// 录像的步号是录制开始后实际模拟的步数：暂停期间不增加，重置或读档也不会让它倒退，
+// 所以一局里读过档、重开过的录像也能从头连续回放。
+// 定期关键帧每隔keyframeInterval步记一个；关键帧总量超过keyframeBudget字节时抽掉一半、间隔加倍，
+// 大网格长时间录制也不会无限占用内存（restore关键帧是回放必需的，不受影响）。
+class ReplayRecorder {
+public:
+    static const int DEFAULT_KEYFRAME_INTERVAL = 1200;             // 默认关键帧间隔（步），60模拟秒
+    static const qint64 DEFAULT_KEYFRAME_BUDGET = 64LL << 20;      // 默认关键帧总量上限（字节）
+
+    explicit ReplayRecorder(int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL,
+                            qint64 keyframeBudget = DEFAULT_KEYFRAME_BUDGET);
+
+    void start(const AlgaeGame& game); // 清空录像，以游戏当前状态为初始关键帧
+
+    // 以下由AlgaeGame调用
+    void recordInput(const AlgaeGame& game, ReplayLog::Input input, int row, int col, bool result = true,
+                     AlgaeType::Type type = AlgaeType::NONE); // 一次玩家操作及其返回值
+    void recordFrame(const AlgaeGame& game);   // 一帧模拟结束：到了间隔就记下定期关键帧
+    void sync(const AlgaeGame& game);          // 把上次之后模拟的步数计入录像步号（状态被整体替换之前调用）
+    void recordRestore(const AlgaeGame& game); // 状态被整体替换之后：记下回放时必须恢复的关键帧
+
+    // 把到目前为止的录像写入文件（录制继续），失败时返回false并在error中给出原因
+    bool save(const AlgaeGame& game, const QString& path, QString* error = nullptr);
+
+    qint64 getTick() const { return m_tick; }
+    int getKeyframeInterval() const { return m_interval; }
+    const ReplayLog& getLog() const { return m_log; }
+
+private:
+    ReplayLog m_log;
+    int m_initialInterval;   // 开始录制时的关键帧间隔
+    int m_interval;          // 当前关键帧间隔（抽稀后加倍）
+    qint64 m_budget;         // 关键帧总量上限
+    qint64 m_tick = 0;       // 录像步号
+    qint64 m_lastSteps = 0;  // 上次同步时游戏的已模拟步数
+    qint64 m_nextKeyframe = 0; // 下一个定期关键帧的步号
+};
+
+#endif // REPLAYRECORDER_H
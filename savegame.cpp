@@ -0,0 +1,241 @@
+#include "savegame.h"   // 游戏存档头文件
+#include <QFile>        // 文件读写
+#include <QSaveFile>    // 写完才替换原文件
+#include <QtEndian>     // 小端序读写
+#include <cstring>
+#include "algaegame.h"  // 游戏主逻辑
+
+namespace {
+
+const char MAGIC[8] = { 'A', 'L', 'G', 'A', 'E', 'S', 'A', 'V' };
+
+// 文件头各字段的偏移
+enum HeaderOffset {
+    OFF_MAGIC = 0,          // char[8]
+    OFF_VERSION = 8,        // quint32
+    OFF_HEADER_SIZE = 12,   // quint32
+    OFF_ROWS = 16,          // qint32
+    OFF_COLS = 20,          // qint32
+    OFF_FLAGS = 24,         // quint32，FLAG_*
+    OFF_SEED = 28,          // quint32
+    OFF_SELECTED = 32,      // qint32
+    OFF_LIGHT_CURVE = 36,   // qint32
+    OFF_LIGHT_SURFACE = 40, // double
+    OFF_LIGHT_DECAY = 48,   // double
+    OFF_LIGHT_MINIMUM = 56, // double
+    OFF_PRODUCE_TIMER = 64, // double
+    OFF_RESOURCES = 72,     // double[4]
+    OFF_SIM_STEPS = 104,    // qint64
+    OFF_PAYLOAD_SIZE = 112, // quint64
+    OFF_CHECKSUM = 120      // quint64
+};
+
+const quint32 FLAG_RESOURCE_SEED = 1u << 0; // 使用固定的资源随机种子
+
+const int DOUBLE_FIELDS = 5; // 数据区中的double数组个数
+const int BYTE_FIELDS = 2;   // 数据区中的quint8数组个数
+
+qint64 payloadSize(qint64 cells)
+{
+    return cells * (DOUBLE_FIELDS * qint64(sizeof(double)) + BYTE_FIELDS);
+}
+
+// 数据区校验和：按小端序每次取8字节的FNV-1a变体，比逐字节快约8倍
+quint64 checksum(const char* data, qint64 size)
+{
+    quint64 hash = 0xcbf29ce484222325ULL;
+    qint64 k = 0;
+    for (; k + 8 <= size; k += 8) {
+        hash = (hash ^ qFromLittleEndian<quint64>(data + k)) * 0x100000001b3ULL;
+    }
+    for (; k < size; ++k) {
+        hash = (hash ^ static_cast<uchar>(data[k])) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+void writeDoubles(char*& out, const std::vector<double>& values)
+{
+    qToLittleEndian<double>(values.data(), static_cast<qsizetype>(values.size()), out);
+    out += values.size() * sizeof(double);
+}
+
+void writeBytes(char*& out, const std::vector<quint8>& values)
+{
+    std::memcpy(out, values.data(), values.size());
+    out += values.size();
+}
+
+void readDoubles(const char*& in, std::vector<double>& values, size_t count)
+{
+    values.resize(count);
+    qFromLittleEndian<double>(in, static_cast<qsizetype>(count), values.data());
+    in += count * sizeof(double);
+}
+
+void readBytes(const char*& in, std::vector<quint8>& values, size_t count)
+{
+    values.assign(reinterpret_cast<const quint8*>(in), reinterpret_cast<const quint8*>(in) + count);
+    in += count;
+}
+
+bool fail(QString* error, const QString& message)
+{
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+} // namespace
+
+SaveGame SaveGame::fromGame(const AlgaeGame& game)
+{
+    SaveGame save;
+    save.capture(game);
+    return save;
+}
+
+void SaveGame::capture(const AlgaeGame& game)
+{
+    game.getGrid()->saveState(grid);
+    const GameResources* res = game.getResources();
+    resources[0] = res->getCarbohydrates();
+    resources[1] = res->getLipids();
+    resources[2] = res->getProteins();
+    resources[3] = res->getVitamins();
+    simSteps = game.getSimStepCount();
+    selectedType = game.getSelectedAlgaeType();
+}
+
+qint64 SaveGame::fileSize(int rows, int cols)
+{
+    return HEADER_SIZE + payloadSize(qint64(rows) * cols);
+}
+
+QByteArray SaveGame::serialize() const
+{
+    const size_t cells = static_cast<size_t>(grid.rows) * grid.cols;
+    QByteArray bytes(fileSize(grid.rows, grid.cols), '\0');
+    char* header = bytes.data();
+    std::memcpy(header + OFF_MAGIC, MAGIC, sizeof(MAGIC));
+    qToLittleEndian<quint32>(VERSION, header + OFF_VERSION);
+    qToLittleEndian<quint32>(HEADER_SIZE, header + OFF_HEADER_SIZE);
+    qToLittleEndian<qint32>(grid.rows, header + OFF_ROWS);
+    qToLittleEndian<qint32>(grid.cols, header + OFF_COLS);
+    qToLittleEndian<quint32>(grid.hasResourceSeed ? FLAG_RESOURCE_SEED : 0u, header + OFF_FLAGS);
+    qToLittleEndian<quint32>(grid.resourceSeed, header + OFF_SEED);
+    qToLittleEndian<qint32>(selectedType, header + OFF_SELECTED);
+    qToLittleEndian<qint32>(grid.lightProfile.curve, header + OFF_LIGHT_CURVE);
+    qToLittleEndian<double>(grid.lightProfile.surface, header + OFF_LIGHT_SURFACE);
+    qToLittleEndian<double>(grid.lightProfile.decay, header + OFF_LIGHT_DECAY);
+    qToLittleEndian<double>(grid.lightProfile.minimum, header + OFF_LIGHT_MINIMUM);
+    qToLittleEndian<double>(grid.produceTimer, header + OFF_PRODUCE_TIMER);
+    for (int i = 0; i < 4; ++i) {
+        qToLittleEndian<double>(resources[i], header + OFF_RESOURCES + i * sizeof(double));
+    }
+    qToLittleEndian<qint64>(simSteps, header + OFF_SIM_STEPS);
+    qToLittleEndian<quint64>(payloadSize(cells), header + OFF_PAYLOAD_SIZE);
+
+    char* out = header + HEADER_SIZE;
+    writeDoubles(out, grid.nitrogen);
+    writeDoubles(out, grid.carbon);
+    writeDoubles(out, grid.nitrogenRegenBase);
+    writeDoubles(out, grid.carbonRegenBase);
+    writeDoubles(out, grid.timeSinceLightLow);
+    writeBytes(out, grid.species);
+    writeBytes(out, grid.status);
+    qToLittleEndian<quint64>(checksum(header + HEADER_SIZE, payloadSize(cells)), header + OFF_CHECKSUM);
+    return bytes;
+}
+
+bool SaveGame::deserialize(const char* data, qint64 size, QString* error)
+{
+    if (size < HEADER_SIZE || std::memcmp(data + OFF_MAGIC, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail(error, "不是存档文件");
+    }
+    const quint32 version = qFromLittleEndian<quint32>(data + OFF_VERSION);
+    if (version != VERSION) {
+        return fail(error, QString("不支持的存档版本%1").arg(version));
+    }
+    const quint32 headerSize = qFromLittleEndian<quint32>(data + OFF_HEADER_SIZE);
+    const qint32 rows = qFromLittleEndian<qint32>(data + OFF_ROWS);
+    const qint32 cols = qFromLittleEndian<qint32>(data + OFF_COLS);
+    if (!GridModel::isValidSize(rows, cols)) {
+        return fail(error, QString("网格尺寸无效：%1x%2").arg(rows).arg(cols));
+    }
+    const qint64 cells = qint64(rows) * cols;
+    const quint64 payload = qFromLittleEndian<quint64>(data + OFF_PAYLOAD_SIZE);
+    if (headerSize < quint32(HEADER_SIZE) || payload != quint64(payloadSize(cells)) ||
+        quint64(size) != headerSize + payload) {
+        return fail(error, "存档长度与文件头不符（文件可能被截断）");
+    }
+    const char* in = data + headerSize;
+    if (checksum(in, qint64(payload)) != qFromLittleEndian<quint64>(data + OFF_CHECKSUM)) {
+        return fail(error, "存档校验和不符（文件已损坏）");
+    }
+    const qint32 selected = qFromLittleEndian<qint32>(data + OFF_SELECTED);
+    const qint32 curve = qFromLittleEndian<qint32>(data + OFF_LIGHT_CURVE);
+    if (selected < AlgaeType::NONE || selected >= AlgaeType::TYPE_COUNT ||
+        (curve != GridModel::LightProfile::LINEAR && curve != GridModel::LightProfile::EXPONENTIAL)) {
+        return fail(error, "存档文件头取值无效");
+    }
+
+    GridModel::State state;
+    state.rows = rows;
+    state.cols = cols;
+    state.hasResourceSeed = qFromLittleEndian<quint32>(data + OFF_FLAGS) & FLAG_RESOURCE_SEED;
+    state.resourceSeed = qFromLittleEndian<quint32>(data + OFF_SEED);
+    state.lightProfile.curve = static_cast<GridModel::LightProfile::Curve>(curve);
+    state.lightProfile.surface = qFromLittleEndian<double>(data + OFF_LIGHT_SURFACE);
+    state.lightProfile.decay = qFromLittleEndian<double>(data + OFF_LIGHT_DECAY);
+    state.lightProfile.minimum = qFromLittleEndian<double>(data + OFF_LIGHT_MINIMUM);
+    state.produceTimer = qFromLittleEndian<double>(data + OFF_PRODUCE_TIMER);
+    readDoubles(in, state.nitrogen, cells);
+    readDoubles(in, state.carbon, cells);
+    readDoubles(in, state.nitrogenRegenBase, cells);
+    readDoubles(in, state.carbonRegenBase, cells);
+    readDoubles(in, state.timeSinceLightLow, cells);
+    readBytes(in, state.species, cells);
+    readBytes(in, state.status, cells);
+    for (qint64 k = 0; k < cells; ++k) {
+        if (state.species[k] >= AlgaeType::TYPE_COUNT || state.status[k] > CellState::DYING) {
+            return fail(error, QString("第%1行第%2列的格子数据无效").arg(k / cols).arg(k % cols));
+        }
+    }
+
+    grid = std::move(state);
+    for (int i = 0; i < 4; ++i) {
+        resources[i] = qFromLittleEndian<double>(data + OFF_RESOURCES + i * sizeof(double));
+    }
+    simSteps = qFromLittleEndian<qint64>(data + OFF_SIM_STEPS);
+    selectedType = static_cast<AlgaeType::Type>(selected);
+    return true;
+}
+
+bool SaveGame::save(const QString& path, QString* error) const
+{
+    const QByteArray bytes = serialize();
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() || !file.commit()) {
+        return fail(error, file.errorString());
+    }
+    return true;
+}
+
+// 整个文件映射到内存后直接解析；映射失败（如特殊文件系统）时退回一次读取
+bool SaveGame::load(const QString& path, QString* error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(error, file.errorString());
+    }
+    const qint64 size = file.size();
+    if (uchar* mapped = size > 0 ? file.map(0, size) : nullptr) {
+        const bool ok = deserialize(reinterpret_cast<const char*>(mapped), size, error);
+        file.unmap(mapped);
+        return ok;
+    }
+    const QByteArray bytes = file.readAll();
+    return deserialize(bytes.constData(), bytes.size(), error);
+}
@@ -0,0 +1,44 @@
+#ifndef SAVEGAME_H // 防止头文件重复包含
+#define SAVEGAME_H
+
+#include <QByteArray> // 序列化结果
+#include <QString>    // Qt字符串类
+#include "algaetype.h" // 藻类类型定义
+#include "gridmodel.h" // 网格模型状态
+
+class AlgaeGame;
+
+// 游戏存档：网格的不可推导状态（GridModel::State）加上资源量、已模拟步数与选中藻类（只依赖QtCore）
+//
+// 二进制格式（小端序，版本VERSION）：HEADER_SIZE字节的定长文件头，后面紧接各字段数组，
+// 每个数组rows*cols个元素、行优先。8字节的数组在前，1字节的在后，每段都自然对齐：
+//   文件头   魔数"ALGAESAV"、版本、文件头长度、行列数、种子标记与种子、选中藻类、光照曲线参数、
+//            产出计时、四种资源量、已模拟步数、数据区长度、数据区校验和（偏移见savegame.cpp）
+//   数据区   double 氮、碳、氮基础恢复速率、碳基础恢复速率、光照低计时；quint8 藻类、状态
+// 读档是一次映射（或一次读取）整个文件，校验文件头、长度、校验和与取值范围后按段复制，不逐字段解析。
+struct SaveGame {
+    static const quint32 VERSION = 1;   // 格式版本，不兼容的改动时递增
+    static const int HEADER_SIZE = 128; // 本版本的文件头长度（读档时按文件中记录的长度定位数据区）
+
+    GridModel::State grid;
+    double resources[4] = { 0.0, 0.0, 0.0, 0.0 }; // 糖、脂质、蛋白质、维生素
+    qint64 simSteps = 0;                         // 已模拟的固定步数
+    AlgaeType::Type selectedType = AlgaeType::NONE;
+
+    // 取游戏当前状态的副本（在游戏所在线程调用，副本可交给其他线程序列化）
+    static SaveGame fromGame(const AlgaeGame& game);
+    // 同fromGame，但复制进本对象已有的数组：尺寸不变时不重新分配，只是按行复制
+    void capture(const AlgaeGame& game);
+
+    QByteArray serialize() const;
+    // 从内存中的完整存档解析，失败时返回false并在error中给出原因
+    bool deserialize(const char* data, qint64 size, QString* error = nullptr);
+
+    // 读写存档文件，失败时返回false并在error中给出原因；写入经临时文件完成后才替换原文件
+    bool save(const QString& path, QString* error = nullptr) const;
+    bool load(const QString& path, QString* error = nullptr);
+
+    static qint64 fileSize(int rows, int cols); // 指定尺寸的存档字节数
+};
+
+#endif // SAVEGAME_H
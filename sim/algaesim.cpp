@@ -0,0 +1,328 @@
+// 无界面批量模拟：加载布局文件，不等定时器、按最快速度推进游戏逻辑若干模拟秒，
+// 输出资源与生产速率的轨迹以及是否达成胜利条件（只依赖QtCore）
+// 加 --replay 时参数为操作录像文件：按录下的操作以最快速度回放，可先跳转到指定时间
+//
+// 用法：algaeplus-sim [选项] 布局文件...
+//       algaeplus-sim --replay [--from 秒] [--verify] 录像文件...
+// 大批量评估时可配合 --summary 每个布局只输出一行，再用xargs -P等工具多进程并行
+#include <QCoreApplication>   // 无界面应用
+#include <QCommandLineParser> // 命令行解析
+#include <QElapsedTimer>      // 计时器
+#include <cstdio>
+#include "algaegame.h"        // 游戏主逻辑
+#include "gridlayout.h"       // 布局文件
+#include "replaylog.h"        // 操作录像
+#include "replayplayer.h"     // 录像回放
+
+namespace {
+
+// 一次模拟的结果
+struct SimResult {
+    int planted = 0;        // 成功种下的格子数
+    int requested = 0;      // 布局中的藻类格子数
+    bool won = false;       // 是否达成胜利条件
+    double winTime = 0.0;   // 首次达成胜利条件的模拟时间（秒）
+    double carb = 0.0, lipid = 0.0, pro = 0.0, vit = 0.0;                 // 结束时的资源量
+    double carbRate = 0.0, lipidRate = 0.0, proRate = 0.0, vitRate = 0.0; // 结束时的生产速率
+    double progress = 0.0;  // 结束时的通关进度
+    double wallMs = 0.0;    // 实际耗时（毫秒）
+};
+
+// 打印一行资源与速率
+void printSample(double time, const GameResources* res)
+{
+    std::printf("%10.2f %10.2f %10.2f %10.2f %10.2f %9.3f %9.3f %9.3f %9.3f %8.3f\n",
+                time, res->getCarbohydrates(), res->getLipids(), res->getProteins(), res->getVitamins(),
+                res->getCarbRate(), res->getLipidRate(), res->getProRate(), res->getVitRate(), res->getWinProgress());
+}
+
+// 按布局种植：默认直接种下（按光照规则判定，不扣种植消耗），charge时走游戏的种植流程并扣除消耗
+void plantLayout(AlgaeGame& game, const GridLayout& layout, bool charge, SimResult& result)
+{
+    GridModel* grid = game.getGrid();
+    if (charge) {
+        game.startGame(); // plantAlgae只在运行状态下生效；没有事件循环，定时器不会触发
+    }
+    for (int row = 0; row < layout.rows; ++row) {
+        for (int col = 0; col < layout.cols; ++col) {
+            const AlgaeType::Type type = layout.at(row, col);
+            if (type == AlgaeType::NONE) {
+                continue;
+            }
+            ++result.requested;
+            bool planted = false;
+            if (charge) {
+                game.setSelectedAlgaeType(type);
+                planted = game.plantAlgae(row, col);
+            } else {
+                const CellState::PlantResult plantResult = grid->plant(row, col, type, grid->getLightAt(row, col), true, true);
+                planted = plantResult == CellState::PLANT_SUCCESS || plantResult == CellState::PLANT_LIGHT_LOW;
+            }
+            if (planted) {
+                ++result.planted;
+            }
+        }
+    }
+    if (charge) {
+        game.pauseGame();
+    }
+}
+
+// 运行一个布局；interval为轨迹输出间隔（秒），不大于0时不输出轨迹
+SimResult runLayout(const GridLayout& layout, const GridModel::LightProfile& light,
+                    double seconds, double interval, bool charge)
+{
+    QElapsedTimer wall;
+    wall.start();
+
+    AlgaeGame game;
+    GridModel* grid = game.getGrid();
+    grid->setResourceSeed(layout.seed);
+    grid->setLightProfile(light);
+    if (!game.resizeGrid(layout.rows, layout.cols)) { // 资源与速率同时回到初始值
+        return SimResult();
+    }
+
+    SimResult result;
+    plantLayout(game, layout, charge, result);
+
+    const GameResources* res = game.getResources();
+    const qint64 totalSteps = qRound64(seconds / AlgaeGame::SIM_STEP);
+    const qint64 sampleSteps = interval > 0.0 ? qMax<qint64>(1, qRound64(interval / AlgaeGame::SIM_STEP)) : 0;
+    if (sampleSteps > 0) {
+        std::printf("%10s %10s %10s %10s %10s %9s %9s %9s %9s %8s\n",
+                    "time", "carb", "lipid", "pro", "vit", "carb/s", "lipid/s", "pro/s", "vit/s", "progress");
+        printSample(0.0, res);
+    }
+    for (qint64 step = 1; step <= totalSteps; ++step) {
+        game.advance(1);
+        if (!result.won && res->checkWinCondition()) {
+            result.won = true;
+            result.winTime = game.getSimTime();
+        }
+        if (sampleSteps > 0 && (step % sampleSteps == 0 || step == totalSteps)) {
+            printSample(game.getSimTime(), res);
+        }
+    }
+    result.carb = res->getCarbohydrates();
+    result.lipid = res->getLipids();
+    result.pro = res->getProteins();
+    result.vit = res->getVitamins();
+    result.carbRate = res->getCarbRate();
+    result.lipidRate = res->getLipidRate();
+    result.proRate = res->getProRate();
+    result.vitRate = res->getVitRate();
+    result.progress = res->getWinProgress();
+    result.wallMs = wall.nsecsElapsed() / 1e6;
+    return result;
+}
+
+// 回放一个录像：先跳转到fromTick，再回放到endTick（不大于0时到录像结束），返回是否与录制时一致
+bool runReplay(const QString& path, const ReplayLog& log, qint64 fromTick, qint64 endTick,
+               double interval, bool verify, bool summary)
+{
+    QElapsedTimer wall;
+    wall.start();
+    AlgaeGame game;
+    game.getGrid()->setThreadCount(1); // 与录制时的线程数无关，单线程避免多个进程并行时争抢
+    ReplayPlayer player(log, game);
+    player.setVerify(verify);
+    if (endTick <= 0) {
+        endTick = log.getEndTick();
+    }
+
+    const GameResources* res = game.getResources();
+    double seekMs = 0.0;
+    if (fromTick > 0) {
+        QElapsedTimer seekTimer;
+        seekTimer.start();
+        player.seek(fromTick);
+        seekMs = seekTimer.nsecsElapsed() / 1e6;
+    }
+    const qint64 sampleSteps = interval > 0.0 && !summary ? qMax<qint64>(1, qRound64(interval / AlgaeGame::SIM_STEP)) : 0;
+    if (!summary) {
+        const GridModel* grid = game.getGrid();
+        std::printf("# replay %s  size %dx%d  ticks %lld  inputs %lld  keyframes %d\n",
+                    qPrintable(path), grid->getRows(), grid->getCols(), static_cast<long long>(log.getEndTick()),
+                    static_cast<long long>(log.getInputCount()), static_cast<int>(log.getKeyframes().size()));
+        if (fromTick > 0) {
+            std::printf("# seek to %.2fs in %.1fms\n", player.getTick() * AlgaeGame::SIM_STEP, seekMs);
+        }
+    }
+    if (sampleSteps > 0) {
+        std::printf("%10s %10s %10s %10s %10s %9s %9s %9s %9s %8s\n",
+                    "time", "carb", "lipid", "pro", "vit", "carb/s", "lipid/s", "pro/s", "vit/s", "progress");
+        printSample(player.getTick() * AlgaeGame::SIM_STEP, res);
+    }
+    while (player.getTick() < endTick) {
+        const qint64 target = sampleSteps > 0 ? qMin(endTick, (player.getTick() / sampleSteps + 1) * sampleSteps) : endTick;
+        player.advanceTo(target);
+        if (sampleSteps > 0) {
+            printSample(player.getTick() * AlgaeGame::SIM_STEP, res);
+        }
+    }
+
+    const bool consistent = player.getDivergedCount() == 0 && player.getMismatchCount() == 0;
+    const double wallMs = wall.nsecsElapsed() / 1e6;
+    if (summary) {
+        std::printf("%-32s %10.2f %8d %8d %8d %8s %10.2f %10.2f %10.2f %10.2f %8.3f %10.1f\n",
+                    qPrintable(path), player.getTick() * AlgaeGame::SIM_STEP, player.getAppliedCount(), player.getDivergedCount(),
+                    player.getMismatchCount(), consistent ? "yes" : "no",
+                    res->getCarbohydrates(), res->getLipids(), res->getProteins(), res->getVitamins(),
+                    res->getWinProgress(), wallMs);
+    } else {
+        std::printf("# inputs applied %d  diverged %d  keyframes restored %d  verified %d  mismatched %d  wall %.1fms\n\n",
+                    player.getAppliedCount(), player.getDivergedCount(), player.getRestoreCount(),
+                    player.getVerifiedCount(), player.getMismatchCount(), wallMs);
+    }
+    std::fflush(stdout);
+    return consistent;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("algaeplus-sim");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("无界面批量运行藻类布局，输出资源/速率轨迹与胜利判定");
+    parser.addHelpOption();
+    QCommandLineOption secondsOption({ "t", "seconds" }, "模拟时长（秒），默认600", "seconds", "600");
+    QCommandLineOption intervalOption({ "i", "interval" }, "轨迹输出间隔（秒），默认10", "seconds", "10");
+    QCommandLineOption seedOption("seed", "覆盖布局文件中的资源随机种子", "seed");
+    QCommandLineOption chargeOption("charge", "按游戏规则扣除种植消耗，买不起的格子跳过");
+    QCommandLineOption summaryOption({ "s", "summary" }, "不输出轨迹，每个布局只输出一行汇总");
+    QCommandLineOption curveOption("light-curve", "基础光照曲线：linear（默认）或exp", "curve", "linear");
+    QCommandLineOption surfaceOption("light-surface", "水面光照，默认30", "light", "30");
+    QCommandLineOption decayOption("light-decay", "每行衰减量（linear）或衰减系数（exp），默认2", "decay", "2");
+    QCommandLineOption minimumOption("light-min", "基础光照下限，默认0", "light", "0");
+    QCommandLineOption replayOption("replay", "参数为操作录像文件，按录下的操作回放（默认到录像结束，-t指定时在该时间停止）");
+    QCommandLineOption fromOption("from", "回放前先跳转到该时间（秒）", "seconds", "0");
+    QCommandLineOption verifyOption("verify", "回放经过定期关键帧时与录制时的状态逐字节比较");
+    parser.addOption(secondsOption);
+    parser.addOption(intervalOption);
+    parser.addOption(seedOption);
+    parser.addOption(chargeOption);
+    parser.addOption(summaryOption);
+    parser.addOption(curveOption);
+    parser.addOption(surfaceOption);
+    parser.addOption(decayOption);
+    parser.addOption(minimumOption);
+    parser.addOption(replayOption);
+    parser.addOption(fromOption);
+    parser.addOption(verifyOption);
+    parser.addPositionalArgument("layouts", "布局文件或（--replay时）录像文件，可多个", "file...");
+    parser.process(app);
+
+    bool ok = false;
+    const double seconds = parser.value(secondsOption).toDouble(&ok);
+    if (!ok || seconds < 0.0) {
+        std::fprintf(stderr, "模拟时长无效\n");
+        return 2;
+    }
+    const double interval = parser.value(intervalOption).toDouble(&ok);
+    if (!ok) {
+        std::fprintf(stderr, "输出间隔无效\n");
+        return 2;
+    }
+    GridModel::LightProfile light;
+    const QString curve = parser.value(curveOption);
+    if (curve == "exp") {
+        light.curve = GridModel::LightProfile::EXPONENTIAL;
+    } else if (curve != "linear") {
+        std::fprintf(stderr, "光照曲线只能是linear或exp\n");
+        return 2;
+    }
+    bool surfaceOk = false, decayOk = false, minimumOk = false;
+    light.surface = parser.value(surfaceOption).toDouble(&surfaceOk);
+    light.decay = parser.value(decayOption).toDouble(&decayOk);
+    light.minimum = parser.value(minimumOption).toDouble(&minimumOk);
+    if (!surfaceOk || !decayOk || !minimumOk) {
+        std::fprintf(stderr, "光照参数无效\n");
+        return 2;
+    }
+    const bool hasSeed = parser.isSet(seedOption);
+    const quint32 seed = hasSeed ? parser.value(seedOption).toUInt(&ok) : 0u;
+    if (hasSeed && !ok) {
+        std::fprintf(stderr, "资源随机种子无效\n");
+        return 2;
+    }
+    const bool summary = parser.isSet(summaryOption);
+    const bool charge = parser.isSet(chargeOption);
+    const QStringList layoutPaths = parser.positionalArguments();
+    if (layoutPaths.isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    if (parser.isSet(replayOption)) {
+        const double from = parser.value(fromOption).toDouble(&ok);
+        if (!ok || from < 0.0) {
+            std::fprintf(stderr, "跳转时间无效\n");
+            return 2;
+        }
+        const qint64 fromTick = qRound64(from / AlgaeGame::SIM_STEP);
+        const qint64 endTick = parser.isSet(secondsOption) ? qMax<qint64>(1, qRound64(seconds / AlgaeGame::SIM_STEP)) : 0;
+        if (summary) {
+            std::printf("%-32s %10s %8s %8s %8s %8s %10s %10s %10s %10s %8s %10s\n",
+                        "replay", "time", "applied", "diverged", "mismatch", "same", "carb", "lipid", "pro", "vit",
+                        "progress", "wall_ms");
+        }
+        int failures = 0;
+        for (const QString& path : layoutPaths) {
+            ReplayLog log;
+            QString error;
+            if (!log.load(path, &error)) {
+                std::fprintf(stderr, "%s: %s\n", qPrintable(path), qPrintable(error));
+                ++failures;
+                continue;
+            }
+            if (!runReplay(path, log, fromTick, endTick, interval, parser.isSet(verifyOption), summary)) {
+                std::fprintf(stderr, "%s: 回放与录制时不一致\n", qPrintable(path));
+                ++failures;
+            }
+        }
+        return failures > 0 ? 1 : 0;
+    }
+
+    if (summary) {
+        std::printf("%-32s %6s %8s %10s %10s %10s %10s %10s %9s %9s %9s %9s %8s %10s\n",
+                    "layout", "won", "win_time", "planted", "carb", "lipid", "pro", "vit",
+                    "carb/s", "lipid/s", "pro/s", "vit/s", "progress", "wall_ms");
+    }
+
+    int failures = 0;
+    for (const QString& path : layoutPaths) {
+        GridLayout layout;
+        QString error;
+        if (!layout.load(path, &error)) {
+            std::fprintf(stderr, "%s: %s\n", qPrintable(path), qPrintable(error));
+            ++failures;
+            continue;
+        }
+        if (hasSeed) {
+            layout.seed = seed;
+        }
+
+        if (!summary) {
+            std::printf("# layout %s  size %dx%d  seed %u\n", qPrintable(path), layout.rows, layout.cols, layout.seed);
+        }
+        const SimResult result = runLayout(layout, light, seconds, summary ? 0.0 : interval, charge);
+        if (summary) {
+            const QString planted = QString("%1/%2").arg(result.planted).arg(result.requested);
+            std::printf("%-32s %6s %8.2f %10s %10.2f %10.2f %10.2f %10.2f %9.3f %9.3f %9.3f %9.3f %8.3f %10.1f\n",
+                        qPrintable(path), result.won ? "yes" : "no", result.won ? result.winTime : -1.0, qPrintable(planted),
+                        result.carb, result.lipid, result.pro, result.vit,
+                        result.carbRate, result.lipidRate, result.proRate, result.vitRate, result.progress, result.wallMs);
+        } else {
+            std::printf("# planted %d/%d  won %s", result.planted, result.requested, result.won ? "yes" : "no");
+            if (result.won) {
+                std::printf(" at %.2fs", result.winTime);
+            }
+            std::printf("  wall %.1fms\n\n", result.wallMs);
+        }
+        std::fflush(stdout);
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+#include "spritecache.h" // 精灵缓存头文件
+#include <QImage>         // 逐像素提亮
+#include <QPainter>       // 烘焙投影
+
+namespace {
+
+const char* const ICON_PATHS[SpriteCache::ICON_COUNT] = {
+    ":/icons/light.png",
+    ":/icons/status.png",
+    ":/icons/nitrogen.png",
+    ":/icons/carbon.png"
+};
+
+} // namespace
+
+SpriteCache* SpriteCache::instance() {
+    static SpriteCache cache;
+    return &cache;
+}
+
+SpriteCache::SpriteCache()
+    : m_cache(MAX_COST_KB),
+      m_hits(0),
+      m_misses(0)
+{
+    for (int type = 0; type < AlgaeType::TYPE_COUNT; ++type) {
+        for (int k = 0; k < SOURCE_COUNT; ++k) {
+            m_sourceLoaded[type][k] = false;
+        }
+    }
+    for (int k = 0; k < ICON_COUNT; ++k) {
+        m_iconLoaded[k] = false;
+    }
+}
+
+// 键：类别1位 | 编号4位 | 变体4位 | 设备像素比（百分之一）12位 | 宽16位 | 高16位
+quint64 SpriteCache::makeKey(int kind, int id, const QSize& size, qreal dpr, int variant)
+{
+    const quint64 ratio = quint64(qBound(1, qRound(dpr * 100), 4095));
+    return (quint64(kind & 1) << 52) | (quint64(id & 0xf) << 48) | (quint64(variant & 0xf) << 44) |
+           (ratio << 32) | (quint64(size.width() & 0xffff) << 16) | quint64(size.height() & 0xffff);
+}
+
+const QPixmap& SpriteCache::source(AlgaeType::Type type, Variant variant)
+{
+    const SourceImage image = variant == VARIANT_FILL_HOVER ? SOURCE_HOVER
+                            : variant == VARIANT_FILL_SELECTED ? SOURCE_SELECTED : SOURCE_IMAGE;
+    if (!m_sourceLoaded[type][image]) {
+        m_sourceLoaded[type][image] = true;
+        if (type != AlgaeType::NONE) {
+            const AlgaeType::Info& info = AlgaeType::getInfo(type);
+            const QString& path = image == SOURCE_HOVER ? info.hoverImagePath
+                                : image == SOURCE_SELECTED ? info.selectedImagePath : info.imagePath;
+            m_sources[type][image] = QPixmap(path);
+        }
+    }
+    return m_sources[type][image];
+}
+
+// 在设备像素上缩放，结果标上设备像素比，按逻辑尺寸绘制时正好一比一贴图
+QPixmap SpriteCache::build(const QPixmap& source, const QSize& size, qreal dpr, Variant variant) const
+{
+    if (source.isNull() || size.isEmpty()) {
+        return QPixmap();
+    }
+    const QSize deviceSize(qRound(size.width() * dpr), qRound(size.height() * dpr));
+    const bool fill = variant == VARIANT_FILL || variant == VARIANT_FILL_HOVER || variant == VARIANT_FILL_SELECTED;
+    QPixmap pixmap = source.scaled(deviceSize, fill ? Qt::IgnoreAspectRatio : Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    if (variant == VARIANT_BRIGHTENED) {
+        QImage image = pixmap.toImage().convertToFormat(QImage::Format_ARGB32);
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                image.setPixelColor(x, y, image.pixelColor(x, y).lighter(130));
+            }
+        }
+        pixmap = QPixmap::fromImage(image);
+    } else if (variant == VARIANT_SHADOW) {
+        QPixmap shadow(pixmap.size());
+        shadow.fill(Qt::transparent);
+        QPainter painter(&shadow);
+        painter.setOpacity(0.4);
+        painter.drawPixmap(0, 0, pixmap);
+        painter.end();
+        pixmap = shadow;
+    }
+    pixmap.setDevicePixelRatio(dpr);
+    return pixmap;
+}
+
+void SpriteCache::insert(quint64 key, const QPixmap& pixmap)
+{
+    const int cost = qMax(1, int(qint64(pixmap.width()) * pixmap.height() * 4 / 1024));
+    m_cache.insert(key, new QPixmap(pixmap), cost); // 超过上限的单张图会被直接丢弃，调用方仍持有副本
+}
+
+QPixmap SpriteCache::sprite(AlgaeType::Type type, const QSize& size, qreal dpr, Variant variant)
+{
+    const quint64 key = makeKey(0, type, size, dpr, variant);
+    if (const QPixmap* cached = m_cache.object(key)) {
+        ++m_hits;
+        return *cached;
+    }
+    ++m_misses;
+    const QPixmap pixmap = build(source(type, variant), size, dpr, variant);
+    insert(key, pixmap);
+    return pixmap;
+}
+
+QPixmap SpriteCache::icon(Icon icon, int size, qreal dpr)
+{
+    const QSize iconSize(size, size);
+    const quint64 key = makeKey(1, icon, iconSize, dpr, VARIANT_FILL);
+    if (const QPixmap* cached = m_cache.object(key)) {
+        ++m_hits;
+        return *cached;
+    }
+    ++m_misses;
+    if (!m_iconLoaded[icon]) {
+        m_iconLoaded[icon] = true;
+        m_iconSources[icon] = QPixmap(ICON_PATHS[icon]);
+    }
+    const QPixmap pixmap = build(m_iconSources[icon], iconSize, dpr, VARIANT_FILL);
+    insert(key, pixmap);
+    return pixmap;
+}
+
+void SpriteCache::prebake(const QSize& size, qreal dpr, int variants)
+{
+    for (int type = AlgaeType::TYPE_A; type < AlgaeType::TYPE_COUNT; ++type) {
+        for (int variant = 0; variant < VARIANT_COUNT; ++variant) {
+            if (variants & (1 << variant)) {
+                sprite(static_cast<AlgaeType::Type>(type), size, dpr, static_cast<Variant>(variant));
+            }
+        }
+    }
+}
+
+void SpriteCache::clear()
+{
+    m_cache.clear();
+}
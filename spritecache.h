@@ -0,0 +1,65 @@
+#ifndef SPRITECACHE_H // 防止头文件重复包含
+#define SPRITECACHE_H
+
+#include <QCache>      // 按代价淘汰的缓存
+#include <QPixmap>     // 像素图
+#include <QSize>
+#include "algaetype.h" // 藻类类型定义
+
+// 预缩放的精灵缓存单例：按（藻类、尺寸、设备像素比、变体）缓存缩放好的像素图
+//
+// 资源系统解码图片、平滑缩放和逐像素提亮都只在第一次用到某个尺寸时做一次，
+// 之后绘制一个格子只需一次drawPixmap。格子尺寸变化时由prebake提前烘焙好该尺寸的全部变体，
+// 缓存超出上限时按最近最少使用淘汰（窗口缩放留下的旧尺寸会先被淘汰）。
+// 只在界面线程使用。
+class SpriteCache {
+public:
+    // 精灵变体
+    enum Variant {
+        VARIANT_NORMAL,        // 等比缩放
+        VARIANT_BRIGHTENED,    // 等比缩放并整体提亮（QColor::lighter(130)）
+        VARIANT_SHADOW,        // 等比缩放、40%不透明度的投影
+        VARIANT_FILL,          // 拉伸填满
+        VARIANT_FILL_HOVER,    // 拉伸填满，鼠标悬停图片
+        VARIANT_FILL_SELECTED, // 拉伸填满，选中图片
+        VARIANT_COUNT
+    };
+
+    // 格子上的小图标
+    enum Icon { ICON_LIGHT, ICON_STATUS, ICON_NITROGEN, ICON_CARBON, ICON_COUNT };
+
+    static const int MAX_COST_KB = 64 * 1024; // 缓存上限（KB，按像素数据估算）
+
+    static SpriteCache* instance(); // 获取单例实例
+
+    // 取指定尺寸（逻辑像素）的精灵，未缓存时现场生成；图片缺失时返回空像素图
+    QPixmap sprite(AlgaeType::Type type, const QSize& size, qreal dpr, Variant variant);
+    // 取指定边长（逻辑像素）的图标
+    QPixmap icon(Icon icon, int size, qreal dpr);
+
+    // 烘焙某个格子尺寸下所有藻类的指定变体（variants为变体标记位，1 << Variant）
+    void prebake(const QSize& size, qreal dpr, int variants);
+
+    void clear();
+    int getHits() const { return m_hits; }     // 命中次数
+    int getMisses() const { return m_misses; } // 生成次数
+
+private:
+    SpriteCache();
+
+    QCache<quint64, QPixmap> m_cache; // 键见makeKey
+    enum SourceImage { SOURCE_IMAGE, SOURCE_HOVER, SOURCE_SELECTED, SOURCE_COUNT };
+    QPixmap m_sources[AlgaeType::TYPE_COUNT][SOURCE_COUNT]; // 解码后的原图
+    bool m_sourceLoaded[AlgaeType::TYPE_COUNT][SOURCE_COUNT];
+    QPixmap m_iconSources[ICON_COUNT];
+    bool m_iconLoaded[ICON_COUNT];
+    int m_hits;
+    int m_misses;
+
+    static quint64 makeKey(int kind, int id, const QSize& size, qreal dpr, int variant);
+    const QPixmap& source(AlgaeType::Type type, Variant variant); // 原图，第一次用到时从资源系统解码
+    QPixmap build(const QPixmap& source, const QSize& size, qreal dpr, Variant variant) const;
+    void insert(quint64 key, const QPixmap& pixmap);
+};
+
+#endif // SPRITECACHE_H
@@ -0,0 +1,109 @@
+#include "uischeduler.h" // 界面刷新调度器头文件
+#include <QTimer>         // 定时器
+#include <cmath>
+
+UiScheduler::UiScheduler(QObject* parent)
+    : QObject(parent),
+      m_timer(new QTimer(this)),
+      m_refreshRate(0.0),
+      m_maxFps(DEFAULT_MAX_FPS),
+      m_interval(1000 / DEFAULT_MAX_FPS),
+      m_dirty(0),
+      m_eventCount(0),
+      m_frameCount(0)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer); // 默认的粗略定时器误差可达5%，会让帧间隔忽长忽短
+    connect(m_timer, &QTimer::timeout, this, &UiScheduler::flush);
+}
+
+void UiScheduler::setRefreshRate(double hz)
+{
+    m_refreshRate = hz;
+    updateInterval();
+}
+
+void UiScheduler::setMaxFps(int fps)
+{
+    m_maxFps = fps;
+    updateInterval();
+}
+
+// 帧率取显示器刷新率与上限中较小的一个，都未设置时按默认上限
+void UiScheduler::updateInterval()
+{
+    double fps = m_maxFps > 0 ? m_maxFps : 0.0;
+    if (m_refreshRate > 0.0 && (fps <= 0.0 || m_refreshRate < fps)) {
+        fps = m_refreshRate;
+    }
+    if (fps <= 0.0) {
+        fps = DEFAULT_MAX_FPS;
+    }
+    m_interval = qMax(1, static_cast<int>(std::floor(1000.0 / fps)));
+}
+
+void UiScheduler::markDirty(int panels)
+{
+    ++m_eventCount;
+    m_dirty |= panels;
+    schedule();
+}
+
+void UiScheduler::markCellDirty(int row, int col)
+{
+    ++m_eventCount;
+    if (!(m_dirty & PANEL_GRID)) {
+        const qint64 key = (qint64(row) << 32) | quint32(col);
+        if (!m_dirtyCellKeys.contains(key)) {
+            if (m_dirtyCells.size() >= MAX_DIRTY_CELLS) {
+                // 脏格子太多时整网格刷新更省事，也让每帧的工作量有上限
+                m_dirty |= PANEL_GRID;
+                m_dirtyCells.clear();
+                m_dirtyCellKeys.clear();
+            } else {
+                m_dirtyCellKeys.insert(key);
+                m_dirtyCells.append(QPoint(row, col));
+                m_dirty |= PANEL_CELLS;
+            }
+        }
+    }
+    schedule();
+}
+
+// 距上一帧不足一个帧间隔时等到间隔满再刷新，否则下一轮事件循环立即刷新
+void UiScheduler::schedule()
+{
+    if (m_timer->isActive()) {
+        return;
+    }
+    int delay = 0;
+    if (m_sinceFrame.isValid()) {
+        delay = qMax<qint64>(0, m_interval - m_sinceFrame.elapsed());
+    }
+    m_timer->start(delay);
+}
+
+void UiScheduler::flushNow()
+{
+    m_timer->stop();
+    flush();
+}
+
+void UiScheduler::flush()
+{
+    if (m_dirty == 0) {
+        return;
+    }
+    // 先取出本帧的脏标记再发信号，刷新过程中新来的通知归入下一帧
+    const int panels = m_dirty;
+    QList<QPoint> cells;
+    if (!(panels & PANEL_GRID)) {
+        cells.swap(m_dirtyCells);
+    }
+    m_dirty = 0;
+    m_dirtyCells.clear();
+    m_dirtyCellKeys.clear();
+    m_sinceFrame.start();
+    ++m_frameCount;
+    emit frame(panels, cells);
+}
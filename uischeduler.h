@@ -0,0 +1,78 @@
+#ifndef UISCHEDULER_H // 防止头文件重复包含
+#define UISCHEDULER_H
+
+#include <QObject>       // Qt对象基类
+#include <QElapsedTimer> // 帧间隔计时
+#include <QList>
+#include <QPoint>
+#include <QSet>
+
+class QTimer;
+
+// 界面刷新调度器：把一帧内的所有模型变化通知合并成一次界面刷新
+//
+// 模型信号只调用markDirty/markCellDirty记下哪些面板需要刷新，不直接改控件；
+// 调度器按显示器刷新率（不超过帧率上限）定时发出一次frame信号，
+// 无论一帧内来了多少次通知，每个面板每帧至多刷新一次。
+// 没有脏面板时不启动定时器，游戏暂停时界面不做任何工作。
+class UiScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    // 可独立刷新的界面面板
+    enum Panel {
+        PANEL_RESOURCES = 1 << 0, // 资源数量
+        PANEL_RATES     = 1 << 1, // 生产速率
+        PANEL_PROGRESS  = 1 << 2, // 通关进度、胜利条件与分数
+        PANEL_GRID      = 1 << 3, // 整张网格（含遮荫区）
+        PANEL_CELLS     = 1 << 4, // 部分格子（见frame信号的cells参数）
+        PANEL_ALL       = PANEL_RESOURCES | PANEL_RATES | PANEL_PROGRESS | PANEL_GRID
+    };
+
+    static const int DEFAULT_MAX_FPS = 60;   // 默认帧率上限
+    static const int MAX_DIRTY_CELLS = 256;  // 单帧脏格子超过此数时改为整网格刷新
+
+    explicit UiScheduler(QObject* parent = nullptr);
+
+    // 显示器刷新率（Hz），不大于0时只按帧率上限
+    void setRefreshRate(double hz);
+    double getRefreshRate() const { return m_refreshRate; }
+    // 帧率上限，不大于0时只按显示器刷新率
+    void setMaxFps(int fps);
+    int getMaxFps() const { return m_maxFps; }
+    int frameInterval() const { return m_interval; } // 当前帧间隔（毫秒）
+
+    void markDirty(int panels);           // 标记面板待刷新
+    void markCellDirty(int row, int col); // 标记单个格子待刷新
+    void flushNow();                      // 不等下一帧，立即刷新已标记的面板
+
+    // 统计：收到的通知数与实际刷新的帧数
+    quint64 getEventCount() const { return m_eventCount; }
+    quint64 getFrameCount() const { return m_frameCount; }
+
+signals:
+    // 每帧一次；panels为本帧的脏面板，cells为PANEL_CELLS对应的格子（行、列存于x、y）
+    void frame(int panels, const QList<QPoint>& cells);
+
+private slots:
+    void flush(); // 定时器到期，发出一帧
+
+private:
+    QTimer* m_timer;          // 单次定时器，有脏面板时才启动
+    QElapsedTimer m_sinceFrame; // 距上一帧的时间
+    double m_refreshRate;     // 显示器刷新率
+    int m_maxFps;             // 帧率上限
+    int m_interval;           // 帧间隔（毫秒）
+
+    int m_dirty;                   // 脏面板标记位
+    QList<QPoint> m_dirtyCells;    // 脏格子（按标记顺序）
+    QSet<qint64> m_dirtyCellKeys;  // 脏格子去重
+
+    quint64 m_eventCount;
+    quint64 m_frameCount;
+
+    void updateInterval();
+    void schedule(); // 按帧间隔启动定时器（已启动则不动）
+};
+
+#endif // UISCHEDULER_H
@@ -0,0 +1,76 @@
+#include "workerpool.h" // 工作线程池头文件
+
+WorkerPool::WorkerPool(int threadCount)
+{
+    for (int i = 1; i < threadCount; ++i) { // 调用线程算作其中一个
+        m_threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(int taskCount, const std::function<void(int)>& task)
+{
+    // 单线程或只有一个任务时直接在调用线程执行
+    if (m_threads.empty() || taskCount <= 1) {
+        for (int i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask.store(0);
+        m_busyWorkers = static_cast<int>(m_threads.size());
+        ++m_batch;
+    }
+    m_wake.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_task = nullptr;
+}
+
+void WorkerPool::drain()
+{
+    for (int i = m_nextTask.fetch_add(1); i < m_taskCount; i = m_nextTask.fetch_add(1)) {
+        (*m_task)(i);
+    }
+}
+
+void WorkerPool::workerLoop()
+{
+    unsigned long long seenBatch = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, seenBatch] { return m_stop || m_batch != seenBatch; });
+            if (m_stop) {
+                return;
+            }
+            seenBatch = m_batch;
+        }
+
+        drain();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0) {
+            m_done.notify_one();
+        }
+    }
+}
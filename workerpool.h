@@ -0,0 +1,43 @@
+#ifndef WORKERPOOL_H // 防止头文件重复包含
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 简单的常驻工作线程池：把一批编号任务[0, taskCount)分给所有线程执行，
+// 调用线程也参与执行，全部完成后run()才返回。任务的执行顺序不固定，
+// 需要确定性结果的调用方应按任务编号分别存放结果，再按编号顺序合并。
+class WorkerPool {
+public:
+    explicit WorkerPool(int threadCount); // 线程总数（含调用线程），至少为1
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int threadCount() const { return static_cast<int>(m_threads.size()) + 1; }
+
+    void run(int taskCount, const std::function<void(int)>& task);
+
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;  // 通知工作线程有新任务批次
+    std::condition_variable m_done;  // 通知调用线程批次已完成
+
+    const std::function<void(int)>* m_task = nullptr; // 当前批次的任务
+    int m_taskCount = 0;               // 当前批次的任务数
+    std::atomic<int> m_nextTask{0};    // 下一个待领取的任务编号
+    int m_busyWorkers = 0;             // 尚未完成当前批次的工作线程数
+    unsigned long long m_batch = 0;    // 批次编号，工作线程据此判断是否有新任务
+    bool m_stop = false;
+
+    void workerLoop();
+    void drain(); // 领取并执行任务，直到本批次任务全部被领取
+};
+
+#endif // WORKERPOOL_H